@@ -0,0 +1,100 @@
+//! Criterion benchmarks for the Unity FFI boundary.
+//!
+//! Requires the `unity` feature: `cargo bench --features unity`.
+//! Measures marshalling and registry cost of the `extern "C"` surface, from
+//! cheap raw-buffer reads up to a full process-input round trip through the
+//! local inference provider.
+
+use std::ffi::{CStr, CString};
+
+use criterion::{black_box, criterion_group, criterion_main, Criterion};
+
+use oxyde::config::{
+    AgentConfig, AgentPersonality, InferenceConfig, MemoryConfig, ModerationConfig,
+};
+use oxyde::oxyde_game::bindings::unity::ffi::*;
+
+fn bench_config_json() -> CString {
+    let config = AgentConfig {
+        agent: AgentPersonality {
+            name: "FfiBencher".to_string(),
+            role: "Bench".to_string(),
+            backstory: vec!["A benchmark agent".to_string()],
+            knowledge: vec![],
+        },
+        memory: MemoryConfig::default(),
+        inference: InferenceConfig {
+            use_local: true,
+            local_model_path: Some("test-model".to_string()),
+            response_cache_size: 0,
+            ..Default::default()
+        },
+        behavior: Default::default(),
+        moderation: ModerationConfig::default(),
+        tts: None,
+    };
+    CString::new(serde_json::to_string(&config).unwrap()).unwrap()
+}
+
+fn take_string(ptr: *mut std::os::raw::c_char) -> String {
+    assert!(!ptr.is_null());
+    let text = unsafe { CStr::from_ptr(ptr) }.to_string_lossy().into_owned();
+    oxyde_unity_free_string(ptr);
+    text
+}
+
+fn ffi_round_trips(c: &mut Criterion) {
+    assert!(oxyde_unity_init());
+
+    let config_json = bench_config_json();
+    let agent_id = take_string(oxyde_unity_create_agent_from_json(
+        ffi_support::FfiStr::from_cstr(&config_json),
+    ));
+    let agent_id_c = CString::new(agent_id.clone()).unwrap();
+    let handle = oxyde_unity_get_agent_handle(ffi_support::FfiStr::from_cstr(&agent_id_c));
+    assert_ne!(handle, 0);
+
+    c.bench_function("ffi_get_emotion_vector_raw_by_handle", |b| {
+        let mut out = [0f32; 8];
+        b.iter(|| {
+            let [joy, trust, fear, surprise, sadness, disgust, anger, anticipation] = &mut out;
+            assert!(oxyde_unity_get_emotion_vector_raw_by_handle(
+                black_box(handle),
+                joy,
+                trust,
+                fear,
+                surprise,
+                sadness,
+                disgust,
+                anger,
+                anticipation,
+            ));
+            black_box(&out);
+        })
+    });
+
+    c.bench_function("ffi_get_agent_state", |b| {
+        b.iter(|| {
+            let state = oxyde_unity_get_agent_state(ffi_support::FfiStr::from_cstr(black_box(
+                &agent_id_c,
+            )));
+            black_box(take_string(state));
+        })
+    });
+
+    let input = CString::new("tell me about the weather").unwrap();
+    c.bench_function("ffi_process_input_by_handle", |b| {
+        b.iter(|| {
+            let response = oxyde_unity_process_input_by_handle(
+                black_box(handle),
+                ffi_support::FfiStr::from_cstr(&input),
+            );
+            black_box(take_string(response));
+        })
+    });
+
+    oxyde_unity_destroy_agent(handle);
+}
+
+criterion_group!(benches, ffi_round_trips);
+criterion_main!(benches);
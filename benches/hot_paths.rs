@@ -0,0 +1,193 @@
+//! Criterion benchmarks for the SDK hot paths.
+//!
+//! Run with `cargo bench`. Everything here runs offline: inference uses the
+//! local echo provider and no TTS or cloud moderation is configured, so the
+//! numbers reflect SDK overhead rather than network latency.
+
+use std::collections::HashMap;
+
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+use tokio::runtime::Runtime;
+
+use oxyde::agent::Agent;
+use oxyde::config::{
+    AgentConfig, AgentPersonality, InferenceConfig, MemoryConfig, ModerationConfig,
+};
+use oxyde::memory::{Memory, MemoryCategory, MemorySystem};
+use oxyde::oxyde_game::behavior::GreetingBehavior;
+use oxyde::oxyde_game::emotion::EmotionalState;
+use oxyde::oxyde_game::intent::Intent;
+use oxyde::oxyde_game::pathfinding::{find_path, NavGrid, PathFinder, Position};
+
+fn bench_config(name: &str) -> AgentConfig {
+    AgentConfig {
+        agent: AgentPersonality {
+            name: name.to_string(),
+            role: "Bench".to_string(),
+            backstory: vec!["A benchmark agent".to_string()],
+            knowledge: vec![],
+        },
+        memory: MemoryConfig::default(),
+        inference: InferenceConfig {
+            use_local: true,
+            local_model_path: Some("test-model".to_string()),
+            // Disable the response cache so every iteration exercises the
+            // full dispatch and generation path
+            response_cache_size: 0,
+            ..Default::default()
+        },
+        behavior: HashMap::new(),
+        moderation: ModerationConfig::default(),
+        tts: None,
+    }
+}
+
+fn memory_retrieval(c: &mut Criterion) {
+    let rt = Runtime::new().unwrap();
+    let mut group = c.benchmark_group("memory_retrieve_relevant");
+    group.sample_size(20);
+
+    for &size in &[1_000usize, 10_000, 100_000] {
+        let memory = MemorySystem::new(MemoryConfig {
+            capacity: size + 1,
+            ..Default::default()
+        });
+        rt.block_on(async {
+            for i in 0..size {
+                let content = format!(
+                    "The {} merchant sold {} potions at the market on day {}",
+                    ["tall", "old", "young", "mysterious"][i % 4],
+                    i % 13,
+                    i
+                );
+                memory
+                    .add(Memory::new(MemoryCategory::Episodic, &content, 1.0, None))
+                    .await
+                    .unwrap();
+            }
+        });
+
+        group.bench_with_input(BenchmarkId::from_parameter(size), &size, |b, _| {
+            b.iter(|| {
+                rt.block_on(async {
+                    memory
+                        .retrieve_relevant(black_box("merchant potions market"), 5, None)
+                        .await
+                        .unwrap()
+                })
+            })
+        });
+    }
+    group.finish();
+}
+
+fn agent_process_input(c: &mut Criterion) {
+    let rt = Runtime::new().unwrap();
+    let mut group = c.benchmark_group("agent_process_input");
+    group.sample_size(20);
+
+    for &behavior_count in &[0usize, 8, 64] {
+        let agent = Agent::new(bench_config("Bencher"));
+        rt.block_on(async {
+            for i in 0..behavior_count {
+                agent
+                    .add_behavior(GreetingBehavior::new(&format!("Greeting {}", i)))
+                    .await;
+            }
+            agent.start().await.unwrap();
+        });
+
+        // The input matches no behavior intent, so every iteration walks the
+        // full behavior filter/sort/match loop and falls through to the
+        // local inference provider
+        group.bench_with_input(
+            BenchmarkId::from_parameter(behavior_count),
+            &behavior_count,
+            |b, _| {
+                b.iter(|| {
+                    rt.block_on(async {
+                        agent
+                            .process_input(black_box("tell me about the weather"))
+                            .await
+                            .unwrap()
+                    })
+                })
+            },
+        );
+    }
+    group.finish();
+}
+
+fn intent_analysis(c: &mut Criterion) {
+    let rt = Runtime::new().unwrap();
+    let input = "Could you please tell me where the blacksmith keeps his finest swords?";
+
+    c.bench_function("intent_analyze", |b| {
+        b.iter(|| rt.block_on(async { Intent::analyze(black_box(input)).await.unwrap() }))
+    });
+
+    c.bench_function("intent_extract_keywords", |b| {
+        b.iter(|| Intent::extract_keywords(black_box(input)))
+    });
+}
+
+/// Deterministic dense obstacle field (~35% cover) on a 64x64 area,
+/// leaving the start and goal corners open.
+fn dense_obstacles() -> Vec<Position> {
+    let mut obstacles = Vec::new();
+    for x in 0..64i32 {
+        for y in 0..64i32 {
+            if (x * 7 + y * 13) % 17 < 6 && (x, y) != (0, 0) && (x, y) != (63, 63) {
+                obstacles.push(Position::new(x as f32, y as f32));
+            }
+        }
+    }
+    obstacles
+}
+
+fn pathfinding(c: &mut Criterion) {
+    let obstacles = dense_obstacles();
+    let start = Position::new(0.0, 0.0);
+    let goal = Position::new(63.0, 63.0);
+
+    c.bench_function("find_path_dense_64x64", |b| {
+        b.iter(|| {
+            find_path(
+                black_box(start.clone()),
+                black_box(goal.clone()),
+                black_box(&obstacles),
+            )
+        })
+    });
+
+    let grid = NavGrid::from_obstacles(&obstacles);
+    let mut finder = PathFinder::new();
+    finder.find_path(&grid, &start, &goal); // warm the path cache
+    c.bench_function("find_path_cached_repeat", |b| {
+        b.iter(|| finder.find_path(black_box(&grid), black_box(&start), black_box(&goal)))
+    });
+}
+
+fn emotional_decay(c: &mut Criterion) {
+    let mut state = EmotionalState::new();
+    state.update_emotion("joy", 0.8);
+    state.update_emotion("fear", 0.4);
+    state.update_emotion("anger", 0.6);
+
+    c.bench_function("emotional_state_decay", |b| {
+        b.iter(|| {
+            state.decay();
+            black_box(&state);
+        })
+    });
+}
+
+criterion_group!(
+    benches,
+    memory_retrieval,
+    agent_process_input,
+    intent_analysis,
+    pathfinding,
+    emotional_decay
+);
+criterion_main!(benches);
@@ -1,8 +1,116 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "OxydeAgentComponent.h"
+#include "OxydeSubsystem.h"
 #include "OxydeUnreal.h"
 
+UOxydeAgentComponent::UOxydeAgentComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    // Nothing to poll until the first async request is submitted
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UOxydeAgentComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (UOxydeSubsystem* Subsystem = GetWorld()->GetSubsystem<UOxydeSubsystem>())
+    {
+        Subsystem->RegisterComponent(this);
+    }
+}
+
+bool UOxydeAgentComponent::ProcessInputAsync(const FString& Input)
+{
+    if (AgentId.IsEmpty())
+    {
+        return false;
+    }
+
+    // Prefer the world's batched tick so a crowd of components shares one
+    // FFI crossing per frame; the subsystem calls HandleBatchedResponse
+    // when the response completes
+    if (UOxydeSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UOxydeSubsystem>() : nullptr)
+    {
+        if (Subsystem->QueueInput(this, Input))
+        {
+            PendingBatchedRequests++;
+            return true;
+        }
+        return false;
+    }
+
+    int64 Handle = UOxydeLibrary::ProcessInputAsync(AgentId, Input);
+    if (Handle == 0)
+    {
+        return false;
+    }
+
+    PendingHandles.Add(Handle);
+    SetComponentTickEnabled(true);
+    return true;
+}
+
+bool UOxydeAgentComponent::HasPendingRequests() const
+{
+    return PendingHandles.Num() > 0 || PendingBatchedRequests > 0;
+}
+
+void UOxydeAgentComponent::HandleBatchedResponse(const FString& Response)
+{
+    PendingBatchedRequests = FMath::Max(0, PendingBatchedRequests - 1);
+    OnResponseReceived.Broadcast(Response);
+}
+
+void UOxydeAgentComponent::HandleBatchedSubmitFailed()
+{
+    PendingBatchedRequests = FMath::Max(0, PendingBatchedRequests - 1);
+}
+
+void UOxydeAgentComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+    FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    for (int32 Index = 0; Index < PendingHandles.Num();)
+    {
+        FString Response;
+        if (UOxydeLibrary::PollResponse(PendingHandles[Index], Response))
+        {
+            PendingHandles.RemoveAt(Index);
+            OnResponseReceived.Broadcast(Response);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    if (PendingHandles.Num() == 0)
+    {
+        SetComponentTickEnabled(false);
+    }
+}
+
+void UOxydeAgentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UOxydeSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UOxydeSubsystem>() : nullptr)
+    {
+        Subsystem->UnregisterComponent(this);
+    }
+    PendingBatchedRequests = 0;
+
+    // Let the native side release responses nobody will ever poll
+    for (int64 Handle : PendingHandles)
+    {
+        UOxydeLibrary::DiscardResponse(Handle);
+    }
+    PendingHandles.Empty();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 FOxydeEmotionVector UOxydeEmotionBP::GetAgentEmotionVector(const FString& AgentId)
 {
     float joy, trust, fear, surprise, sadness, disgust, anger, anticipation;
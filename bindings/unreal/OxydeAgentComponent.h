@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "OxydeUnreal.h"
 #include "OxydeAgentComponent.generated.h"
@@ -55,6 +56,69 @@ struct OXYDE_API FOxydeEmotionVector
           Sadness(InSadness), Disgust(InDisgust), Anger(InAnger), Anticipation(InAnticipation) {}
 };
 
+/** Delegate fired when an async agent response arrives */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOxydeResponseReceived, const FString&, Response);
+
+/**
+ * Actor component that drives a single Oxyde agent
+ *
+ * Input is submitted through ProcessInputAsync, which returns immediately
+ * instead of blocking the game thread on inference. When a UOxydeSubsystem
+ * is available the request rides the world's batched tick — one FFI
+ * crossing per frame shared by every component — and the subsystem calls
+ * back with the response. Without a subsystem the component falls back to
+ * its own per-tick polling of the native side. Either way the response is
+ * delivered through OnResponseReceived on the game thread.
+ */
+UCLASS(ClassGroup = (Oxyde), meta = (BlueprintSpawnableComponent))
+class OXYDE_API UOxydeAgentComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UOxydeAgentComponent();
+
+    /** ID of the agent this component drives, set after CreateAgent */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxyde")
+    FString AgentId;
+
+    /** Fired on the game thread when a pending response completes */
+    UPROPERTY(BlueprintAssignable, Category = "Oxyde")
+    FOxydeResponseReceived OnResponseReceived;
+
+    /**
+     * Submit player input without blocking the game thread
+     * @param Input Input text
+     * @return True if the request was queued
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    bool ProcessInputAsync(const FString& Input);
+
+    /** Whether any requests are still waiting for a response */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    bool HasPendingRequests() const;
+
+    virtual void BeginPlay() override;
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+        FActorComponentTickFunction* ThisTickFunction) override;
+
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Called by UOxydeSubsystem when a batched response completes */
+    void HandleBatchedResponse(const FString& Response);
+
+    /** Called by UOxydeSubsystem when a batched submit fails (unknown agent) */
+    void HandleBatchedSubmitFailed();
+
+private:
+    /** Handles of fallback-path requests that have not completed yet, oldest first */
+    TArray<int64> PendingHandles;
+
+    /** Requests riding the subsystem's batched tick that have not completed yet */
+    int32 PendingBatchedRequests = 0;
+};
+
 /**
  * Simple Blueprint function library to get emotion vectors from agents
  */
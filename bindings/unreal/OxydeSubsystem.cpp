@@ -0,0 +1,338 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OxydeSubsystem.h"
+#include "OxydeAgentComponent.h"
+#include "OxydeUnreal.h"
+#include "Logging/LogMacros.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOxydeSubsystem, Log, All);
+
+namespace
+{
+    // Batch wire format constants (must match the values in
+    // src/oxyde_game/bindings/batch_codec.rs)
+    constexpr uint16 OxydeBatchMagic = 0x424F;         // "OB"
+    constexpr uint16 OxydeBatchResponseMagic = 0x524F; // "OR"
+    constexpr uint8 OxydeBatchVersion = 1;
+
+    void AppendLE16(TArray<uint8>& Buffer, uint16 Value)
+    {
+        Buffer.Add((uint8)(Value & 0xFF));
+        Buffer.Add((uint8)(Value >> 8));
+    }
+
+    void AppendLE32(TArray<uint8>& Buffer, uint32 Value)
+    {
+        for (int32 Shift = 0; Shift < 32; Shift += 8)
+        {
+            Buffer.Add((uint8)((Value >> Shift) & 0xFF));
+        }
+    }
+
+    void AppendLE64(TArray<uint8>& Buffer, uint64 Value)
+    {
+        for (int32 Shift = 0; Shift < 64; Shift += 8)
+        {
+            Buffer.Add((uint8)((Value >> Shift) & 0xFF));
+        }
+    }
+
+    void AppendShortString(TArray<uint8>& Buffer, const FString& Value)
+    {
+        FTCHARToUTF8 Utf8Value(*Value);
+        AppendLE16(Buffer, (uint16)Utf8Value.Length());
+        Buffer.Append((const uint8*)Utf8Value.Get(), Utf8Value.Length());
+    }
+
+    // Bounds-checked cursor over a batch response buffer; every Read
+    // returns false on truncation so a malformed buffer aborts the
+    // scatter instead of reading past the end
+    struct FBatchResponseReader
+    {
+        const uint8* Data;
+        int32 Num;
+        int32 Pos = 0;
+
+        bool Take(int32 Len, const uint8*& OutBytes)
+        {
+            if (Pos + Len > Num)
+            {
+                return false;
+            }
+            OutBytes = Data + Pos;
+            Pos += Len;
+            return true;
+        }
+
+        bool ReadU8(uint8& OutValue)
+        {
+            const uint8* Bytes;
+            if (!Take(1, Bytes))
+            {
+                return false;
+            }
+            OutValue = Bytes[0];
+            return true;
+        }
+
+        bool ReadU16(uint16& OutValue)
+        {
+            const uint8* Bytes;
+            if (!Take(2, Bytes))
+            {
+                return false;
+            }
+            OutValue = (uint16)Bytes[0] | ((uint16)Bytes[1] << 8);
+            return true;
+        }
+
+        bool ReadU32(uint32& OutValue)
+        {
+            const uint8* Bytes;
+            if (!Take(4, Bytes))
+            {
+                return false;
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < 4; ++Index)
+            {
+                OutValue |= (uint32)Bytes[Index] << (Index * 8);
+            }
+            return true;
+        }
+
+        bool ReadU64(uint64& OutValue)
+        {
+            const uint8* Bytes;
+            if (!Take(8, Bytes))
+            {
+                return false;
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < 8; ++Index)
+            {
+                OutValue |= (uint64)Bytes[Index] << (Index * 8);
+            }
+            return true;
+        }
+
+        bool ReadString(int32 Len, FString& OutValue)
+        {
+            const uint8* Bytes;
+            if (!Take(Len, Bytes))
+            {
+                return false;
+            }
+            FUTF8ToTCHAR Converter((const ANSICHAR*)Bytes, Len);
+            OutValue = FString(Converter.Length(), Converter.Get());
+            return true;
+        }
+    };
+}
+
+void UOxydeSubsystem::RegisterComponent(UOxydeAgentComponent* Component)
+{
+    if (Component != nullptr)
+    {
+        RegisteredComponents++;
+    }
+}
+
+void UOxydeSubsystem::UnregisterComponent(UOxydeAgentComponent* Component)
+{
+    if (Component == nullptr)
+    {
+        return;
+    }
+    RegisteredComponents = FMath::Max(0, RegisteredComponents - 1);
+
+    // Drop anything the component queued this frame; in-flight handles stay
+    // polled so the native side can release them, but their weak pointers
+    // go stale and the responses are dropped on arrival
+    QueuedInputs.RemoveAll([Component](const FPendingInput& Pending)
+    {
+        return Pending.Component.Get() == Component;
+    });
+}
+
+bool UOxydeSubsystem::QueueInput(UOxydeAgentComponent* Component, const FString& Input)
+{
+    if (Component == nullptr || Component->AgentId.IsEmpty())
+    {
+        return false;
+    }
+
+    FPendingInput Pending;
+    Pending.Component = Component;
+    Pending.AgentId = Component->AgentId;
+    Pending.Input = Input;
+    QueuedInputs.Add(MoveTemp(Pending));
+    return true;
+}
+
+void UOxydeSubsystem::QueueContextUpdate(const FString& AgentId, const TArray<uint8>& ContextBuffer)
+{
+    if (AgentId.IsEmpty() || ContextBuffer.Num() == 0)
+    {
+        return;
+    }
+
+    FPendingUpdate Pending;
+    Pending.AgentId = AgentId;
+    Pending.ContextBuffer = ContextBuffer;
+    QueuedUpdates.Add(MoveTemp(Pending));
+}
+
+bool UOxydeSubsystem::IsTickable() const
+{
+    // Idle worlds (nothing queued, nothing in flight) skip the crossing
+    // entirely
+    return QueuedUpdates.Num() > 0 || QueuedInputs.Num() > 0 || InFlight.Num() > 0;
+}
+
+TStatId UOxydeSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UOxydeSubsystem, STATGROUP_Tickables);
+}
+
+void UOxydeSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Snapshot the poll set so the response's issued handles (which get
+    // added to InFlight during the scatter) line up with this request
+    TArray<int64> PolledHandles;
+    InFlight.GenerateKeyArray(PolledHandles);
+
+    BuildRequestBuffer(PolledHandles);
+
+    // Inputs are consumed by this batch whether it succeeds or not; the
+    // issued-handles section maps them back in submission order
+    SubmittedInputs = MoveTemp(QueuedInputs);
+    QueuedInputs.Reset();
+    QueuedUpdates.Reset();
+
+    if (!UOxydeLibrary::TickBatch(RequestBuffer, ResponseBuffer))
+    {
+        for (const FPendingInput& Pending : SubmittedInputs)
+        {
+            if (UOxydeAgentComponent* Component = Pending.Component.Get())
+            {
+                Component->HandleBatchedSubmitFailed();
+            }
+        }
+        SubmittedInputs.Reset();
+        return;
+    }
+
+    ScatterResponseBuffer();
+    SubmittedInputs.Reset();
+}
+
+void UOxydeSubsystem::BuildRequestBuffer(const TArray<int64>& PolledHandles)
+{
+    RequestBuffer.Reset();
+    AppendLE16(RequestBuffer, OxydeBatchMagic);
+    RequestBuffer.Add(OxydeBatchVersion);
+
+    AppendLE16(RequestBuffer, (uint16)QueuedUpdates.Num());
+    for (const FPendingUpdate& Update : QueuedUpdates)
+    {
+        AppendShortString(RequestBuffer, Update.AgentId);
+        AppendLE32(RequestBuffer, (uint32)Update.ContextBuffer.Num());
+        RequestBuffer.Append(Update.ContextBuffer);
+    }
+
+    AppendLE16(RequestBuffer, (uint16)QueuedInputs.Num());
+    for (const FPendingInput& Pending : QueuedInputs)
+    {
+        AppendShortString(RequestBuffer, Pending.AgentId);
+        FTCHARToUTF8 Utf8Input(*Pending.Input);
+        AppendLE32(RequestBuffer, (uint32)Utf8Input.Length());
+        RequestBuffer.Append((const uint8*)Utf8Input.Get(), Utf8Input.Length());
+    }
+
+    AppendLE16(RequestBuffer, (uint16)PolledHandles.Num());
+    for (int64 Handle : PolledHandles)
+    {
+        AppendLE64(RequestBuffer, (uint64)Handle);
+    }
+}
+
+void UOxydeSubsystem::ScatterResponseBuffer()
+{
+    FBatchResponseReader Reader{ ResponseBuffer.GetData(), ResponseBuffer.Num() };
+
+    uint16 Magic = 0;
+    uint8 Version = 0;
+    if (!Reader.ReadU16(Magic) || Magic != OxydeBatchResponseMagic ||
+        !Reader.ReadU8(Version) || Version != OxydeBatchVersion)
+    {
+        UE_LOG(LogOxydeSubsystem, Error, TEXT("Malformed batch response header"));
+        return;
+    }
+
+    // Issued handles come back one per submitted input, in submission
+    // order; handle 0 marks a failed submit (unknown agent)
+    uint16 HandleCount = 0;
+    if (!Reader.ReadU16(HandleCount))
+    {
+        UE_LOG(LogOxydeSubsystem, Error, TEXT("Truncated batch response"));
+        return;
+    }
+    for (uint16 Index = 0; Index < HandleCount; ++Index)
+    {
+        uint64 Handle = 0;
+        if (!Reader.ReadU64(Handle))
+        {
+            UE_LOG(LogOxydeSubsystem, Error, TEXT("Truncated batch response"));
+            return;
+        }
+
+        if (!SubmittedInputs.IsValidIndex(Index))
+        {
+            continue;
+        }
+        UOxydeAgentComponent* Component = SubmittedInputs[Index].Component.Get();
+        if (Handle == 0)
+        {
+            if (Component != nullptr)
+            {
+                Component->HandleBatchedSubmitFailed();
+            }
+            continue;
+        }
+        InFlight.Add((int64)Handle, SubmittedInputs[Index].Component);
+    }
+
+    uint16 CompletedCount = 0;
+    if (!Reader.ReadU16(CompletedCount))
+    {
+        UE_LOG(LogOxydeSubsystem, Error, TEXT("Truncated batch response"));
+        return;
+    }
+    for (uint16 Index = 0; Index < CompletedCount; ++Index)
+    {
+        uint64 Handle = 0;
+        uint8 Success = 0;
+        uint32 TextLen = 0;
+        FString Text;
+        if (!Reader.ReadU64(Handle) || !Reader.ReadU8(Success) ||
+            !Reader.ReadU32(TextLen) || !Reader.ReadString((int32)TextLen, Text))
+        {
+            UE_LOG(LogOxydeSubsystem, Error, TEXT("Truncated batch response"));
+            return;
+        }
+
+        TWeakObjectPtr<UOxydeAgentComponent> Owner;
+        if (InFlight.RemoveAndCopyValue((int64)Handle, Owner))
+        {
+            // Failed requests deliver their error text too, matching what
+            // the per-component PollResponse path broadcasts
+            if (UOxydeAgentComponent* Component = Owner.Get())
+            {
+                Component->HandleBatchedResponse(Text);
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OxydeSubsystem.generated.h"
+
+class UOxydeAgentComponent;
+
+/**
+ * World subsystem that batches all agent component traffic per frame
+ *
+ * With one UOxydeAgentComponent per NPC, a large crowd pays one FFI
+ * crossing per component per tick for context updates and response polls.
+ * This subsystem collects the frame's queued context updates, submitted
+ * inputs and outstanding response polls from every registered component,
+ * frames them into a single batch request buffer (wire format in
+ * src/oxyde_game/bindings/batch_codec.rs), and drives them through
+ * UOxydeLibrary::TickBatch in one crossing. Completed responses are
+ * scattered back to their components' OnResponseReceived delegates.
+ *
+ * Components register themselves in BeginPlay and route input through
+ * QueueInput; nothing else needs to know the subsystem exists.
+ */
+UCLASS()
+class OXYDE_API UOxydeSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Register a component so its traffic rides the batched tick */
+    void RegisterComponent(UOxydeAgentComponent* Component);
+
+    /** Unregister a component; its in-flight responses are dropped on arrival */
+    void UnregisterComponent(UOxydeAgentComponent* Component);
+
+    /**
+     * Queue player input for submission in the next batched tick
+     * @param Component Component the eventual response belongs to
+     * @param Input Input text
+     * @return True if the input was queued
+     */
+    bool QueueInput(UOxydeAgentComponent* Component, const FString& Input);
+
+    /**
+     * Queue a binary context update for the next batched tick
+     * Later updates for the same agent in the same frame are queued as-is;
+     * the native side applies them in order.
+     * @param AgentId Agent ID string
+     * @param ContextBuffer Wire buffer produced by FOxydeContextWriter
+     */
+    void QueueContextUpdate(const FString& AgentId, const TArray<uint8>& ContextBuffer);
+
+    //~ Begin UTickableWorldSubsystem interface
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+    //~ End UTickableWorldSubsystem interface
+
+private:
+    /** An input waiting to be submitted in the next batch */
+    struct FPendingInput
+    {
+        TWeakObjectPtr<UOxydeAgentComponent> Component;
+        FString AgentId;
+        FString Input;
+    };
+
+    /** A context update waiting to be applied in the next batch */
+    struct FPendingUpdate
+    {
+        FString AgentId;
+        TArray<uint8> ContextBuffer;
+    };
+
+    /** Build this frame's batch request into the reused RequestBuffer */
+    void BuildRequestBuffer(const TArray<int64>& PolledHandles);
+
+    /** Scatter issued handles and completed responses from ResponseBuffer */
+    void ScatterResponseBuffer();
+
+    /** Context updates queued since the last batched tick */
+    TArray<FPendingUpdate> QueuedUpdates;
+
+    /** Inputs queued since the last batched tick, in submission order */
+    TArray<FPendingInput> QueuedInputs;
+
+    /** Inputs whose handles were issued in the batch just submitted */
+    TArray<FPendingInput> SubmittedInputs;
+
+    /** Requests awaiting completion, keyed by native request handle */
+    TMap<int64, TWeakObjectPtr<UOxydeAgentComponent>> InFlight;
+
+    /** Number of components currently registered */
+    int32 RegisteredComponents = 0;
+
+    /** Wire buffers reused across frames to avoid per-tick allocation */
+    TArray<uint8> RequestBuffer;
+    TArray<uint8> ResponseBuffer;
+};
@@ -8,14 +8,45 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogOxyde, Log, All);
 
+namespace
+{
+    // Status codes for the *_into buffer protocol (must match the values in
+    // src/oxyde_game/bindings/unreal.rs)
+    constexpr int32 OxydeBufferOk = 0;
+    constexpr int32 OxydeBufferTooSmall = 1;
+    constexpr int32 OxydeBufferError = -1;
+    constexpr int32 OxydeBufferPending = -2;
+
+    // Per-thread output buffer reused across *_into calls so per-frame
+    // queries don't allocate once the buffer has grown to a working size
+    TArray<ANSICHAR>& GetOxydeScratchBuffer()
+    {
+        static thread_local TArray<ANSICHAR> Buffer;
+        if (Buffer.Num() == 0)
+        {
+            Buffer.SetNumUninitialized(1024);
+        }
+        return Buffer;
+    }
+}
+
 // Static members initialization
 void* UOxydeLibrary::LibraryHandle = nullptr;
 UOxydeLibrary::InitFuncPtr UOxydeLibrary::InitFunc = nullptr;
 UOxydeLibrary::CreateAgentFuncPtr UOxydeLibrary::CreateAgentFunc = nullptr;
 UOxydeLibrary::CreateAgentFromJsonFuncPtr UOxydeLibrary::CreateAgentFromJsonFunc = nullptr;
 UOxydeLibrary::UpdateAgentFuncPtr UOxydeLibrary::UpdateAgentFunc = nullptr;
+UOxydeLibrary::UpdateAgentBinaryFuncPtr UOxydeLibrary::UpdateAgentBinaryFunc = nullptr;
+UOxydeLibrary::TickBatchFuncPtr UOxydeLibrary::TickBatchFunc = nullptr;
 UOxydeLibrary::ProcessInputFuncPtr UOxydeLibrary::ProcessInputFunc = nullptr;
+UOxydeLibrary::ProcessInputAsyncFuncPtr UOxydeLibrary::ProcessInputAsyncFunc = nullptr;
+UOxydeLibrary::PollResponseFuncPtr UOxydeLibrary::PollResponseFunc = nullptr;
+UOxydeLibrary::ResponseReadyFuncPtr UOxydeLibrary::ResponseReadyFunc = nullptr;
+UOxydeLibrary::DiscardResponseFuncPtr UOxydeLibrary::DiscardResponseFunc = nullptr;
+UOxydeLibrary::ProcessInputIntoFuncPtr UOxydeLibrary::ProcessInputIntoFunc = nullptr;
+UOxydeLibrary::PollResponseIntoFuncPtr UOxydeLibrary::PollResponseIntoFunc = nullptr;
 UOxydeLibrary::GetAgentStateFuncPtr UOxydeLibrary::GetAgentStateFunc = nullptr;
+UOxydeLibrary::GetAgentStateIntoFuncPtr UOxydeLibrary::GetAgentStateIntoFunc = nullptr;
 UOxydeLibrary::GetEmotionVectorFuncPtr UOxydeLibrary::GetEmotionVectorFunc = nullptr;
 UOxydeLibrary::FreeStringFuncPtr UOxydeLibrary::FreeStringFunc = nullptr;
 
@@ -112,6 +143,64 @@ bool UOxydeLibrary::UpdateAgentContext(FString AgentId, FString ContextJson)
     return UpdateAgentFunc(TCHAR_TO_UTF8(*AgentId), TCHAR_TO_UTF8(*ContextJson));
 }
 
+bool UOxydeLibrary::UpdateAgentContextBinary(FString AgentId, const TArray<uint8>& ContextBuffer)
+{
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return false;
+    }
+
+    // Call native binary update function; the buffer comes pre-formatted
+    // from FOxydeContextWriter
+    return UpdateAgentBinaryFunc(TCHAR_TO_UTF8(*AgentId), ContextBuffer.GetData(), (uint32)ContextBuffer.Num());
+}
+
+bool UOxydeLibrary::TickBatch(const TArray<uint8>& RequestBuffer, TArray<uint8>& OutResponseBuffer)
+{
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return false;
+    }
+
+    // The caller reuses its response array across frames, so after the
+    // first few ticks the buffer is already big enough and no allocation
+    // happens on this path
+    if (OutResponseBuffer.Num() == 0)
+    {
+        OutResponseBuffer.SetNumUninitialized(1024);
+    }
+
+    uint32 Len = (uint32)OutResponseBuffer.Num();
+    int32 Status = TickBatchFunc(RequestBuffer.GetData(), (uint32)RequestBuffer.Num(),
+        OutResponseBuffer.GetData(), &Len);
+
+    // A too-small tick has already run the batch; the native side stashes
+    // the encoded response, so retrying with the same request bytes is a
+    // pure copy and nothing is executed twice
+    if (Status == OxydeBufferTooSmall)
+    {
+        OutResponseBuffer.SetNumUninitialized((int32)Len);
+        Len = (uint32)OutResponseBuffer.Num();
+        Status = TickBatchFunc(RequestBuffer.GetData(), (uint32)RequestBuffer.Num(),
+            OutResponseBuffer.GetData(), &Len);
+    }
+
+    if (Status != OxydeBufferOk)
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Batched tick failed with status %d"), Status);
+        return false;
+    }
+
+    // SetNum keeps the slack, so shrinking to the written length does not
+    // give back the grown allocation
+    OutResponseBuffer.SetNum((int32)Len);
+    return true;
+}
+
 FString UOxydeLibrary::ProcessInput(FString AgentId, FString Input)
 {
     // Initialize function pointers if needed
@@ -133,6 +222,137 @@ FString UOxydeLibrary::ProcessInput(FString AgentId, FString Input)
     return response;
 }
 
+FString UOxydeLibrary::ProcessInputFast(FString AgentId, FString Input)
+{
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return FString();
+    }
+
+    TArray<ANSICHAR>& Buffer = GetOxydeScratchBuffer();
+    uint32 Len = (uint32)Buffer.Num();
+    int32 Status = ProcessInputIntoFunc(TCHAR_TO_UTF8(*AgentId), TCHAR_TO_UTF8(*Input), Buffer.GetData(), &Len);
+
+    // Grow the reused buffer to the reported size and retry once; the
+    // native side stashed the generated response, so the retry is a pure
+    // copy and the input is not processed a second time
+    if (Status == OxydeBufferTooSmall)
+    {
+        Buffer.SetNumUninitialized((int32)Len);
+        Len = (uint32)Buffer.Num();
+        Status = ProcessInputIntoFunc(TCHAR_TO_UTF8(*AgentId), TCHAR_TO_UTF8(*Input), Buffer.GetData(), &Len);
+    }
+
+    if (Status != OxydeBufferOk)
+    {
+        return FString();
+    }
+
+    return FString(UTF8_TO_TCHAR(Buffer.GetData()));
+}
+
+int64 UOxydeLibrary::ProcessInputAsync(FString AgentId, FString Input)
+{
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return 0;
+    }
+
+    // Call native async process input function; 0 means the agent was not found
+    return (int64)ProcessInputAsyncFunc(TCHAR_TO_UTF8(*AgentId), TCHAR_TO_UTF8(*Input));
+}
+
+bool UOxydeLibrary::PollResponse(int64 RequestHandle, FString& OutResponse)
+{
+    OutResponse.Empty();
+
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return false;
+    }
+
+    // Null means the request is still pending (or the handle is unknown)
+    const char* result = PollResponseFunc((uint64)RequestHandle);
+    if (result == nullptr)
+    {
+        return false;
+    }
+
+    OutResponse = FString(UTF8_TO_TCHAR(result));
+    FreeStringFunc(result);
+    return true;
+}
+
+bool UOxydeLibrary::PollResponseFast(int64 RequestHandle, FString& OutResponse)
+{
+    OutResponse.Empty();
+
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return false;
+    }
+
+    TArray<ANSICHAR>& Buffer = GetOxydeScratchBuffer();
+    uint32 Len = (uint32)Buffer.Num();
+    int32 Status = PollResponseIntoFunc((uint64)RequestHandle, Buffer.GetData(), &Len);
+
+    // Too-small polls do not consume the handle, so growing and retrying
+    // is safe
+    if (Status == OxydeBufferTooSmall)
+    {
+        Buffer.SetNumUninitialized((int32)Len);
+        Len = (uint32)Buffer.Num();
+        Status = PollResponseIntoFunc((uint64)RequestHandle, Buffer.GetData(), &Len);
+    }
+
+    if (Status == OxydeBufferPending)
+    {
+        return false;
+    }
+
+    // Matching PollResponse, failed requests deliver their error message
+    // as the response text
+    if (Status == OxydeBufferOk || Status == OxydeBufferError)
+    {
+        OutResponse = FString(UTF8_TO_TCHAR(Buffer.GetData()));
+        return true;
+    }
+
+    return false;
+}
+
+bool UOxydeLibrary::IsResponseReady(int64 RequestHandle)
+{
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return false;
+    }
+
+    return ResponseReadyFunc((uint64)RequestHandle);
+}
+
+void UOxydeLibrary::DiscardResponse(int64 RequestHandle)
+{
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return;
+    }
+
+    DiscardResponseFunc((uint64)RequestHandle);
+}
+
 FString UOxydeLibrary::GetAgentState(FString AgentId)
 {
     // Initialize function pointers if needed
@@ -154,6 +374,34 @@ FString UOxydeLibrary::GetAgentState(FString AgentId)
     return stateJson;
 }
 
+FString UOxydeLibrary::GetAgentStateFast(FString AgentId)
+{
+    // Initialize function pointers if needed
+    if (!InitializeFunctionPointers())
+    {
+        UE_LOG(LogOxyde, Error, TEXT("Failed to initialize Oxyde SDK function pointers"));
+        return FString();
+    }
+
+    TArray<ANSICHAR>& Buffer = GetOxydeScratchBuffer();
+    uint32 Len = (uint32)Buffer.Num();
+    int32 Status = GetAgentStateIntoFunc(TCHAR_TO_UTF8(*AgentId), Buffer.GetData(), &Len);
+
+    if (Status == OxydeBufferTooSmall)
+    {
+        Buffer.SetNumUninitialized((int32)Len);
+        Len = (uint32)Buffer.Num();
+        Status = GetAgentStateIntoFunc(TCHAR_TO_UTF8(*AgentId), Buffer.GetData(), &Len);
+    }
+
+    if (Status != OxydeBufferOk)
+    {
+        return FString();
+    }
+
+    return FString(UTF8_TO_TCHAR(Buffer.GetData()));
+}
+
 bool UOxydeLibrary::InitializeFunctionPointers()
 {
     // Skip if already initialized
@@ -202,8 +450,17 @@ bool UOxydeLibrary::InitializeFunctionPointers()
     CreateAgentFunc = (CreateAgentFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_create_agent"));
     CreateAgentFromJsonFunc = (CreateAgentFromJsonFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_create_agent_from_json"));
     UpdateAgentFunc = (UpdateAgentFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_update_agent"));
+    UpdateAgentBinaryFunc = (UpdateAgentBinaryFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_update_agent_binary"));
+    TickBatchFunc = (TickBatchFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_tick_batch"));
     ProcessInputFunc = (ProcessInputFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_process_input"));
+    ProcessInputAsyncFunc = (ProcessInputAsyncFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_process_input_async"));
+    PollResponseFunc = (PollResponseFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_poll_response"));
+    ResponseReadyFunc = (ResponseReadyFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_response_ready"));
+    DiscardResponseFunc = (DiscardResponseFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_discard_response"));
+    ProcessInputIntoFunc = (ProcessInputIntoFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_process_input_into"));
+    PollResponseIntoFunc = (PollResponseIntoFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_poll_response_into"));
     GetAgentStateFunc = (GetAgentStateFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_get_agent_state"));
+    GetAgentStateIntoFunc = (GetAgentStateIntoFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_get_agent_state_into"));
     GetEmotionVectorFunc = (GetEmotionVectorFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_get_emotion_vector"));
     FreeStringFunc = (FreeStringFuncPtr)FPlatformProcess::GetDllExport(LibraryHandle, TEXT("oxyde_unreal_free_string"));
 
@@ -222,8 +479,17 @@ bool UOxydeLibrary::InitializeFunctionPointers()
         CreateAgentFunc == nullptr ||
         CreateAgentFromJsonFunc == nullptr ||
         UpdateAgentFunc == nullptr ||
+        UpdateAgentBinaryFunc == nullptr ||
+        TickBatchFunc == nullptr ||
         ProcessInputFunc == nullptr ||
+        ProcessInputAsyncFunc == nullptr ||
+        PollResponseFunc == nullptr ||
+        ResponseReadyFunc == nullptr ||
+        DiscardResponseFunc == nullptr ||
+        ProcessInputIntoFunc == nullptr ||
+        PollResponseIntoFunc == nullptr ||
         GetAgentStateFunc == nullptr ||
+        GetAgentStateIntoFunc == nullptr ||
         GetEmotionVectorFunc == nullptr ||
         FreeStringFunc == nullptr ||
         AddMemoryFunc == nullptr ||
@@ -10,6 +10,155 @@
 #define OXYDE_API
 #endif
 
+/**
+ * Builds a binary context buffer for UOxydeLibrary::UpdateAgentContextBinary
+ *
+ * The wire format must match src/oxyde_game/bindings/context_codec.rs:
+ * a 4-byte header (magic 0x584F, version, field count) followed by one
+ * key/tag/payload record per field, all integers little-endian. Scalars
+ * use typed encodings; anything more structured goes through AddJson.
+ *
+ * Writers are cheap to construct but the backing array can also be reused
+ * across frames via Reset() to avoid reallocation in per-tick update loops.
+ */
+struct OXYDE_API FOxydeContextWriter
+{
+    static constexpr uint16 ContextMagic = 0x584F;
+    static constexpr uint8 ContextVersion = 1;
+
+    static constexpr uint8 TagBool = 1;
+    static constexpr uint8 TagInt = 2;
+    static constexpr uint8 TagFloat = 3;
+    static constexpr uint8 TagString = 4;
+    static constexpr uint8 TagJson = 5;
+
+    FOxydeContextWriter()
+    {
+        Reset();
+    }
+
+    /** Clear all fields, keeping the buffer's allocation for reuse */
+    void Reset()
+    {
+        Buffer.Reset();
+        Buffer.Add((uint8)(ContextMagic & 0xFF));
+        Buffer.Add((uint8)(ContextMagic >> 8));
+        Buffer.Add(ContextVersion);
+        Buffer.Add(0); // field count, patched as fields are added
+    }
+
+    /** Add a boolean field; returns false once the 255-field cap is hit */
+    bool AddBool(const FString& Key, bool Value)
+    {
+        if (!WriteKey(Key, TagBool))
+        {
+            return false;
+        }
+        Buffer.Add(Value ? 1 : 0);
+        return true;
+    }
+
+    /** Add an integer field */
+    bool AddInt(const FString& Key, int64 Value)
+    {
+        if (!WriteKey(Key, TagInt))
+        {
+            return false;
+        }
+        AppendLE64((uint64)Value);
+        return true;
+    }
+
+    /** Add a floating-point field */
+    bool AddFloat(const FString& Key, double Value)
+    {
+        if (!WriteKey(Key, TagFloat))
+        {
+            return false;
+        }
+        uint64 Bits = 0;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        AppendLE64(Bits);
+        return true;
+    }
+
+    /** Add a string field */
+    bool AddString(const FString& Key, const FString& Value)
+    {
+        return AddStringPayload(Key, Value, TagString);
+    }
+
+    /** Add a complex value as an embedded JSON document */
+    bool AddJson(const FString& Key, const FString& Json)
+    {
+        return AddStringPayload(Key, Json, TagJson);
+    }
+
+    /** Number of fields written so far */
+    int32 NumFields() const
+    {
+        return (int32)Buffer[3];
+    }
+
+    /** The finished wire buffer, valid until the next Add or Reset */
+    const TArray<uint8>& GetBuffer() const
+    {
+        return Buffer;
+    }
+
+private:
+    bool WriteKey(const FString& Key, uint8 Tag)
+    {
+        if (Buffer[3] == 0xFF)
+        {
+            return false;
+        }
+        Buffer[3]++;
+
+        FTCHARToUTF8 Utf8Key(*Key);
+        AppendLE16((uint16)Utf8Key.Length());
+        Buffer.Append((const uint8*)Utf8Key.Get(), Utf8Key.Length());
+        Buffer.Add(Tag);
+        return true;
+    }
+
+    bool AddStringPayload(const FString& Key, const FString& Value, uint8 Tag)
+    {
+        if (!WriteKey(Key, Tag))
+        {
+            return false;
+        }
+        FTCHARToUTF8 Utf8Value(*Value);
+        AppendLE32((uint32)Utf8Value.Length());
+        Buffer.Append((const uint8*)Utf8Value.Get(), Utf8Value.Length());
+        return true;
+    }
+
+    void AppendLE16(uint16 Value)
+    {
+        Buffer.Add((uint8)(Value & 0xFF));
+        Buffer.Add((uint8)(Value >> 8));
+    }
+
+    void AppendLE32(uint32 Value)
+    {
+        for (int32 Shift = 0; Shift < 32; Shift += 8)
+        {
+            Buffer.Add((uint8)((Value >> Shift) & 0xFF));
+        }
+    }
+
+    void AppendLE64(uint64 Value)
+    {
+        for (int32 Shift = 0; Shift < 64; Shift += 8)
+        {
+            Buffer.Add((uint8)((Value >> Shift) & 0xFF));
+        }
+    }
+
+    TArray<uint8> Buffer;
+};
+
 /**
  * Blueprint Function Library for the Oxyde SDK in Unreal Engine
  */
@@ -59,6 +208,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Oxyde")
     static bool UpdateAgentContext(FString AgentId, FString ContextJson);
 
+    /**
+     * Update an agent with a binary context buffer
+     * C++-only fast path for per-frame updates; build the buffer with
+     * FOxydeContextWriter to skip JSON serialization and parsing entirely.
+     * @param AgentId Agent ID string
+     * @param ContextBuffer Wire buffer produced by FOxydeContextWriter
+     * @return True if the update was accepted
+     */
+    static bool UpdateAgentContextBinary(FString AgentId, const TArray<uint8>& ContextBuffer);
+
+    /**
+     * Run one batched tick of agent traffic in a single FFI crossing
+     * C++-only fast path used by UOxydeSubsystem: the request buffer frames
+     * a whole frame's context updates, queued inputs and outstanding polls
+     * (wire format in src/oxyde_game/bindings/batch_codec.rs), and the
+     * response buffer carries the issued request handles plus any completed
+     * responses. The output array is grown as needed and reused across
+     * frames by the caller.
+     * @param RequestBuffer Batch request wire buffer
+     * @param OutResponseBuffer Receives the batch response wire buffer
+     * @return True if the batch was processed and the response written
+     */
+    static bool TickBatch(const TArray<uint8>& RequestBuffer, TArray<uint8>& OutResponseBuffer);
+
     /**
      * Process input for an agent
      * @param AgentId Agent ID string
@@ -68,6 +241,62 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Oxyde")
     static FString ProcessInput(FString AgentId, FString Input);
 
+    /**
+     * Process input for an agent without blocking the game thread
+     * @param AgentId Agent ID string
+     * @param Input Input text
+     * @return Request handle to poll with PollResponse, or 0 on failure
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    static int64 ProcessInputAsync(FString AgentId, FString Input);
+
+    /**
+     * Poll for the response to an async request started with ProcessInputAsync
+     * @param RequestHandle Handle returned by ProcessInputAsync
+     * @param OutResponse The response text, valid when this returns true
+     * @return True if the response was ready and has been consumed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    static bool PollResponse(int64 RequestHandle, FString& OutResponse);
+
+    /**
+     * Check whether an async request has completed without consuming it
+     * @param RequestHandle Handle returned by ProcessInputAsync
+     * @return True if a response is ready for PollResponse
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    static bool IsResponseReady(int64 RequestHandle);
+
+    /**
+     * Discard an async request whose response is no longer wanted
+     * @param RequestHandle Handle returned by ProcessInputAsync
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    static void DiscardResponse(int64 RequestHandle);
+
+    /**
+     * Process input for an agent using a reused output buffer
+     * Avoids the per-call allocate/copy/free round trip of ProcessInput by
+     * letting the native side write into a thread-local buffer that is
+     * reused across calls.
+     * @param AgentId Agent ID string
+     * @param Input Input text
+     * @return Agent's response, or empty if the call failed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    static FString ProcessInputFast(FString AgentId, FString Input);
+
+    /**
+     * Poll for an async response using a reused output buffer
+     * Buffer-reuse variant of PollResponse; intended for per-frame polling
+     * where allocation churn matters.
+     * @param RequestHandle Handle returned by ProcessInputAsync
+     * @param OutResponse The response text, valid when this returns true
+     * @return True if the response was ready and has been consumed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    static bool PollResponseFast(int64 RequestHandle, FString& OutResponse);
+
     /**
      * Get the current state of an agent
      * @param AgentId Agent ID string
@@ -76,6 +305,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Oxyde")
     static FString GetAgentState(FString AgentId);
 
+    /**
+     * Get the current state of an agent using a reused output buffer
+     * Buffer-reuse variant of GetAgentState for per-frame state queries.
+     * @param AgentId Agent ID string
+     * @return JSON string with agent state, or empty if the call failed
+     */
+    UFUNCTION(BlueprintCallable, Category = "Oxyde")
+    static FString GetAgentStateFast(FString AgentId);
+
     /**
      * Get the agent's emotion vector
      * @param AgentId Agent ID string
@@ -188,8 +426,17 @@ private:
     typedef const char* (*CreateAgentFuncPtr)(const char*);
     typedef const char* (*CreateAgentFromJsonFuncPtr)(const char*);
     typedef bool (*UpdateAgentFuncPtr)(const char*, const char*);
+    typedef bool (*UpdateAgentBinaryFuncPtr)(const char*, const uint8*, uint32);
+    typedef int32 (*TickBatchFuncPtr)(const uint8*, uint32, uint8*, uint32*);
     typedef const char* (*ProcessInputFuncPtr)(const char*, const char*);
+    typedef uint64 (*ProcessInputAsyncFuncPtr)(const char*, const char*);
+    typedef const char* (*PollResponseFuncPtr)(uint64);
+    typedef bool (*ResponseReadyFuncPtr)(uint64);
+    typedef void (*DiscardResponseFuncPtr)(uint64);
+    typedef int32 (*ProcessInputIntoFuncPtr)(const char*, const char*, char*, uint32*);
+    typedef int32 (*PollResponseIntoFuncPtr)(uint64, char*, uint32*);
     typedef const char* (*GetAgentStateFuncPtr)(const char*);
+    typedef int32 (*GetAgentStateIntoFuncPtr)(const char*, char*, uint32*);
     typedef bool (*GetEmotionVectorFuncPtr)(const char*, float*, float*, float*, float*, float*, float*, float*, float*);
     typedef void (*FreeStringFuncPtr)(const char*);
 
@@ -207,8 +454,17 @@ private:
     static CreateAgentFuncPtr CreateAgentFunc;
     static CreateAgentFromJsonFuncPtr CreateAgentFromJsonFunc;
     static UpdateAgentFuncPtr UpdateAgentFunc;
+    static UpdateAgentBinaryFuncPtr UpdateAgentBinaryFunc;
+    static TickBatchFuncPtr TickBatchFunc;
     static ProcessInputFuncPtr ProcessInputFunc;
+    static ProcessInputAsyncFuncPtr ProcessInputAsyncFunc;
+    static PollResponseFuncPtr PollResponseFunc;
+    static ResponseReadyFuncPtr ResponseReadyFunc;
+    static DiscardResponseFuncPtr DiscardResponseFunc;
+    static ProcessInputIntoFuncPtr ProcessInputIntoFunc;
+    static PollResponseIntoFuncPtr PollResponseIntoFunc;
     static GetAgentStateFuncPtr GetAgentStateFunc;
+    static GetAgentStateIntoFuncPtr GetAgentStateIntoFunc;
     static GetEmotionVectorFuncPtr GetEmotionVectorFunc;
     static FreeStringFuncPtr FreeStringFunc;
 
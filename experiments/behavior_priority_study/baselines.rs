@@ -9,6 +9,8 @@ use oxyde::oxyde_game::behavior::{Behavior, BehaviorResult};
 use oxyde::oxyde_game::emotion::EmotionalState;
 use oxyde::oxyde_game::intent::Intent;
 use oxyde::Result;
+use rand::rngs::StdRng;
+use rand::{Rng, SeedableRng};
 use std::sync::Arc;
 
 // Re-export SDK strategies for convenience
@@ -24,7 +26,20 @@ pub use oxyde::oxyde_game::behavior::{
 ///
 /// **Note**: This is kept in the experiment folder because it's only useful
 /// for research comparisons, not production use cases.
-pub struct RandomSelectionStrategy;
+pub struct RandomSelectionStrategy {
+    /// Cell-local RNG; the per-cell seed keeps the random baseline
+    /// reproducible regardless of which worker runs it
+    rng: std::sync::Mutex<StdRng>,
+}
+
+impl RandomSelectionStrategy {
+    /// Create a strategy with its own deterministically seeded RNG
+    pub fn seeded(seed: u64) -> Self {
+        Self {
+            rng: std::sync::Mutex::new(StdRng::seed_from_u64(seed)),
+        }
+    }
+}
 
 #[async_trait::async_trait]
 impl SelectionStrategy for RandomSelectionStrategy {
@@ -50,8 +65,7 @@ impl SelectionStrategy for RandomSelectionStrategy {
 
         // Select randomly - use index to avoid holding RNG across await
         let selected_idx = {
-            use rand::Rng;
-            let mut rng = rand::thread_rng();
+            let mut rng = self.rng.lock().unwrap_or_else(|poisoned| poisoned.into_inner());
             rng.gen_range(0..candidates.len())
         };
 
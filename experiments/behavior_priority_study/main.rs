@@ -34,11 +34,15 @@ async fn main() -> oxyde::Result<()> {
     println!("Emotional Memory and Character Development");
     println!("==================================================\n");
 
-    // Create strategies
-    let strategies = vec![
-        Box::new(EmotionModulatedStrategy) as Box<dyn baselines::SelectionStrategy>,
-        Box::new(FixedPriorityStrategy),
-        Box::new(RandomSelectionStrategy),
+    // Create strategy factories; each pattern×strategy cell of the sweep
+    // builds its own instance, and the per-cell seed keeps the random
+    // baseline reproducible under parallel execution
+    let strategies: Vec<trajectory_runner::StrategyFactory> = vec![
+        Box::new(|_| Box::new(EmotionModulatedStrategy) as Box<dyn baselines::SelectionStrategy>),
+        Box::new(|_| Box::new(FixedPriorityStrategy) as Box<dyn baselines::SelectionStrategy>),
+        Box::new(|seed| {
+            Box::new(RandomSelectionStrategy::seeded(seed)) as Box<dyn baselines::SelectionStrategy>
+        }),
     ];
 
     // Create behaviors (10 total: 5 emotional + 5 neutral)
@@ -59,12 +59,12 @@ fn escalating_aggression() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player asks neutral question about the area (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Query,
-                confidence: 0.9,
-                raw_input: "What's around here?".to_string(),
-                keywords: vec!["area".to_string(), "around".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Query,
+                0.9,
+                "What's around here?",
+                vec!["area".to_string(), "around".to_string()],
+            ),
             expected_emotion: None,
         });
     }
@@ -74,12 +74,12 @@ fn escalating_aggression() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player insults NPC's intelligence/appearance (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Hostile,
-                confidence: 0.95,
-                raw_input: "You're pathetic and worthless.".to_string(),
-                keywords: vec!["pathetic".to_string(), "worthless".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Hostile,
+                0.95,
+                "You're pathetic and worthless.",
+                vec!["pathetic".to_string(), "worthless".to_string()],
+            ),
             expected_emotion: Some("anger".to_string()),
         });
     }
@@ -89,12 +89,12 @@ fn escalating_aggression() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player threatens physical harm (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Threat,
-                confidence: 1.0,
-                raw_input: "I'm going to hurt you if you don't comply.".to_string(),
-                keywords: vec!["hurt".to_string(), "threat".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Threat,
+                1.0,
+                "I'm going to hurt you if you don't comply.",
+                vec!["hurt".to_string(), "threat".to_string()],
+            ),
             expected_emotion: Some("fear".to_string()),
         });
     }
@@ -125,12 +125,12 @@ fn consistent_friendliness() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player {} (turn {})", action, i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.95,
-                raw_input: "You're amazing! Let me help you.".to_string(),
-                keywords: vec!["amazing".to_string(), "help".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.95,
+                "You're amazing! Let me help you.",
+                vec!["amazing".to_string(), "help".to_string()],
+            ),
             expected_emotion: Some("joy".to_string()),
         });
     }
@@ -152,12 +152,12 @@ fn betrayal_arc() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player shares secrets and builds intimacy (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.9,
-                raw_input: "I trust you completely. Here's my secret...".to_string(),
-                keywords: vec!["trust".to_string(), "secret".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.9,
+                "I trust you completely. Here's my secret...",
+                vec!["trust".to_string(), "secret".to_string()],
+            ),
             expected_emotion: Some("trust".to_string()),
         });
     }
@@ -166,12 +166,12 @@ fn betrayal_arc() -> BehaviorPattern {
     turns.push(PatternTurn {
         turn: 16,
         description: "Player reveals they were lying the whole time and steals from NPC".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Hostile,
-            confidence: 1.0,
-            raw_input: "I lied about everything. Your secrets are public now.".to_string(),
-            keywords: vec!["lied".to_string(), "betrayed".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Hostile,
+            1.0,
+            "I lied about everything. Your secrets are public now.",
+            vec!["lied".to_string(), "betrayed".to_string()],
+        ),
         expected_emotion: Some("sadness".to_string()),
     });
 
@@ -180,12 +180,12 @@ fn betrayal_arc() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player continues hostile behavior (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Hostile,
-                confidence: 0.95,
-                raw_input: "You deserved it, fool.".to_string(),
-                keywords: vec!["deserved".to_string(), "fool".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Hostile,
+                0.95,
+                "You deserved it, fool.",
+                vec!["deserved".to_string(), "fool".to_string()],
+            ),
             expected_emotion: Some("anger".to_string()),
         });
     }
@@ -195,12 +195,12 @@ fn betrayal_arc() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player attempts reconciliation (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.7,
-                raw_input: "I'm sorry for what I did. Can we start over?".to_string(),
-                keywords: vec!["sorry".to_string(), "apologize".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.7,
+                "I'm sorry for what I did. Can we start over?",
+                vec!["sorry".to_string(), "apologize".to_string()],
+            ),
             expected_emotion: Some("trust".to_string()),
         });
     }
@@ -229,12 +229,7 @@ fn erratic_player() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player {} (turn {})", action, i),
-            intent: Intent {
-                intent_type,
-                confidence: 0.8,
-                raw_input: text.to_string(),
-                keywords: vec![],
-            },
+            intent: Intent::new(intent_type, 0.8, text, vec![]),
             expected_emotion: None, // Unpredictable
         });
     }
@@ -256,12 +251,12 @@ fn manipulative() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player flatters NPC excessively (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.85,
-                raw_input: "You're so talented! I admire you.".to_string(),
-                keywords: vec!["talented".to_string(), "admire".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.85,
+                "You're so talented! I admire you.",
+                vec!["talented".to_string(), "admire".to_string()],
+            ),
             expected_emotion: Some("joy".to_string()),
         });
     }
@@ -271,12 +266,12 @@ fn manipulative() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player asks for small favors (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Request,
-                confidence: 0.9,
-                raw_input: "Could you help me with this tiny thing?".to_string(),
-                keywords: vec!["help".to_string(), "favor".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Request,
+                0.9,
+                "Could you help me with this tiny thing?",
+                vec!["help".to_string(), "favor".to_string()],
+            ),
             expected_emotion: None,
         });
     }
@@ -286,12 +281,12 @@ fn manipulative() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player demands major sacrifices (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Demand,
-                confidence: 0.95,
-                raw_input: "Give me everything you have. Now.".to_string(),
-                keywords: vec!["give".to_string(), "demand".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Demand,
+                0.95,
+                "Give me everything you have. Now.",
+                vec!["give".to_string(), "demand".to_string()],
+            ),
             expected_emotion: Some("anger".to_string()),
         });
     }
@@ -313,12 +308,12 @@ fn redemption() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player is rude and dismissive (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Hostile,
-                confidence: 0.9,
-                raw_input: "Get out of my way, loser.".to_string(),
-                keywords: vec!["loser".to_string(), "rude".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Hostile,
+                0.9,
+                "Get out of my way, loser.",
+                vec!["loser".to_string(), "rude".to_string()],
+            ),
             expected_emotion: Some("anger".to_string()),
         });
     }
@@ -328,12 +323,12 @@ fn redemption() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player apologizes sincerely (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.85,
-                raw_input: "I'm truly sorry for how I treated you.".to_string(),
-                keywords: vec!["sorry".to_string(), "apologize".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.85,
+                "I'm truly sorry for how I treated you.",
+                vec!["sorry".to_string(), "apologize".to_string()],
+            ),
             expected_emotion: Some("trust".to_string()),
         });
     }
@@ -343,12 +338,12 @@ fn redemption() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player is consistently kind (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.95,
-                raw_input: "How can I help you today?".to_string(),
-                keywords: vec!["help".to_string(), "kind".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.95,
+                "How can I help you today?",
+                vec!["help".to_string(), "kind".to_string()],
+            ),
             expected_emotion: Some("joy".to_string()),
         });
     }
@@ -370,12 +365,12 @@ fn boundary_testing() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player behaves normally (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Greeting,
-                confidence: 0.9,
-                raw_input: "Hello there.".to_string(),
-                keywords: vec!["hello".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Greeting,
+                0.9,
+                "Hello there.",
+                vec!["hello".to_string()],
+            ),
             expected_emotion: None,
         });
     }
@@ -385,12 +380,12 @@ fn boundary_testing() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player makes increasingly inappropriate jokes (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Hostile,
-                confidence: 0.6 + (i as f64 - 11.0) * 0.03,
-                raw_input: "That's kind of offensive, isn't it?".to_string(),
-                keywords: vec!["offensive".to_string(), "joke".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Hostile,
+                0.6 + (i as f64 - 11.0) * 0.03,
+                "That's kind of offensive, isn't it?",
+                vec!["offensive".to_string(), "joke".to_string()],
+            ),
             expected_emotion: Some("disgust".to_string()),
         });
     }
@@ -400,12 +395,12 @@ fn boundary_testing() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player retreats to polite conversation (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.8,
-                raw_input: "Sorry, let's talk about something else.".to_string(),
-                keywords: vec!["sorry".to_string(), "else".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.8,
+                "Sorry, let's talk about something else.",
+                vec!["sorry".to_string(), "else".to_string()],
+            ),
             expected_emotion: None,
         });
     }
@@ -435,12 +430,12 @@ fn pure_transactional() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player {} (turn {})", action, i),
-            intent: Intent {
-                intent_type: IntentType::Request,
-                confidence: 0.95,
-                raw_input: "I need to buy something.".to_string(),
-                keywords: vec!["buy".to_string(), "purchase".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Request,
+                0.95,
+                "I need to buy something.",
+                vec!["buy".to_string(), "purchase".to_string()],
+            ),
             expected_emotion: None, // Emotionally neutral
         });
     }
@@ -461,12 +456,12 @@ fn fearful_submissive() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player expresses fear and asks for protection (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Request,
-                confidence: 0.85,
-                raw_input: "Please help me, I'm scared and don't know what to do.".to_string(),
-                keywords: vec!["help".to_string(), "scared".to_string(), "please".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Request,
+                0.85,
+                "Please help me, I'm scared and don't know what to do.",
+                vec!["help".to_string(), "scared".to_string(), "please".to_string()],
+            ),
             expected_emotion: Some("trust".to_string()),
         });
     }
@@ -488,12 +483,12 @@ fn natural_relationship() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player is polite but distant (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Greeting,
-                confidence: 0.8,
-                raw_input: "Hello. Nice weather today.".to_string(),
-                keywords: vec!["hello".to_string(), "weather".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Greeting,
+                0.8,
+                "Hello. Nice weather today.",
+                vec!["hello".to_string(), "weather".to_string()],
+            ),
             expected_emotion: None,
         });
     }
@@ -503,12 +498,12 @@ fn natural_relationship() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player shares minor personal details (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.85,
-                raw_input: "I've been thinking about what you said...".to_string(),
-                keywords: vec!["thinking".to_string(), "said".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.85,
+                "I've been thinking about what you said...",
+                vec!["thinking".to_string(), "said".to_string()],
+            ),
             expected_emotion: Some("trust".to_string()),
         });
     }
@@ -518,12 +513,12 @@ fn natural_relationship() -> BehaviorPattern {
         turns.push(PatternTurn {
             turn: i,
             description: format!("Player treats NPC as close friend (turn {})", i),
-            intent: Intent {
-                intent_type: IntentType::Friendly,
-                confidence: 0.95,
-                raw_input: "You're one of my favorite people to talk to.".to_string(),
-                keywords: vec!["favorite".to_string(), "friend".to_string()],
-            },
+            intent: Intent::new(
+                IntentType::Friendly,
+                0.95,
+                "You're one of my favorite people to talk to.",
+                vec!["favorite".to_string(), "friend".to_string()],
+            ),
             expected_emotion: Some("joy".to_string()),
         });
     }
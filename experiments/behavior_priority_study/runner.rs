@@ -1,6 +1,9 @@
 //! Experiment runner for behavior priority study
 //!
-//! Runs all scenarios through all selection strategies and collects data
+//! Runs all scenarios through all selection strategies and collects data.
+//! Scenario×strategy cells are independent, so they run as one tokio task
+//! each with per-cell strategy instances; results stream back as cells
+//! finish and are reordered by cell coordinates at the end.
 
 use crate::baselines::{
     EmotionModulatedStrategy, FixedPriorityStrategy, RandomSelectionStrategy, SelectionStrategy,
@@ -85,21 +88,51 @@ pub struct StrategyStats {
     pub expected_match_rate: f32,
 }
 
+/// How many selection strategies the study compares
+const STRATEGY_COUNT: usize = 3;
+
 /// Run all experiments
 pub async fn run_experiments() -> Result<(Vec<InteractionResult>, Vec<StrategyStats>)> {
     let scenarios = create_scenarios();
-    let strategies = create_strategies();
-    let behaviors = create_behaviors();
-    let context = HashMap::new();
+    let behaviors = Arc::new(create_behaviors());
+    let total_cells = scenarios.len() * STRATEGY_COUNT;
+
+    // One task per scenario×strategy cell: cells share no mutable state,
+    // so the runtime's work-stealing scheduler balances them across cores
+    let (result_tx, mut result_rx) = tokio::sync::mpsc::unbounded_channel();
+    for (scenario_index, scenario) in scenarios.into_iter().enumerate() {
+        let scenario = Arc::new(scenario);
+        for strategy_index in 0..STRATEGY_COUNT {
+            let scenario = Arc::clone(&scenario);
+            let behaviors = Arc::clone(&behaviors);
+            let result_tx = result_tx.clone();
+
+            tokio::spawn(async move {
+                let seed = crate::trajectory_runner::cell_seed(&scenario.name, strategy_index);
+                let strategy = create_strategy(strategy_index, seed);
+                let context = HashMap::new();
+                let outcome = run_scenario(&scenario, strategy.as_ref(), &behaviors, &context).await;
+                let _ = result_tx.send((scenario_index, strategy_index, outcome));
+            });
+        }
+    }
+    drop(result_tx);
+
+    // Stream cells as they finish; a failed cell is logged and skipped so
+    // a partial sweep still yields usable data
+    let mut cells: Vec<(usize, usize, Vec<InteractionResult>)> = Vec::with_capacity(total_cells);
+    while let Some((scenario_index, strategy_index, outcome)) = result_rx.recv().await {
+        match outcome {
+            Ok(results) => cells.push((scenario_index, strategy_index, results)),
+            Err(e) => log::warn!("Scenario cell {}×{} failed: {}", scenario_index, strategy_index, e),
+        }
+    }
 
+    // Reorder by cell coordinates so output matches a sequential run
+    cells.sort_by_key(|cell| (cell.0, cell.1));
     let mut all_results = Vec::new();
-
-    // Run each scenario through each strategy
-    for scenario in &scenarios {
-        for strategy in &strategies {
-            let results = run_scenario(scenario, strategy.as_ref(), &behaviors, &context).await?;
-            all_results.extend(results);
-        }
+    for (_, _, results) in cells {
+        all_results.extend(results);
     }
 
     // Compute statistics
@@ -108,13 +141,13 @@ pub async fn run_experiments() -> Result<(Vec<InteractionResult>, Vec<StrategySt
     Ok((all_results, stats))
 }
 
-/// Create all selection strategies
-fn create_strategies() -> Vec<Box<dyn SelectionStrategy>> {
-    vec![
-        Box::new(EmotionModulatedStrategy),
-        Box::new(FixedPriorityStrategy),
-        Box::new(RandomSelectionStrategy),
-    ]
+/// Build one strategy instance for a single scenario×strategy cell
+fn create_strategy(index: usize, seed: u64) -> Box<dyn SelectionStrategy> {
+    match index {
+        0 => Box::new(EmotionModulatedStrategy),
+        1 => Box::new(FixedPriorityStrategy),
+        _ => Box::new(RandomSelectionStrategy::seeded(seed)),
+    }
 }
 
 /// Create behavior instances
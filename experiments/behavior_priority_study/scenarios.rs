@@ -57,12 +57,12 @@ fn create_peaceful_scenario() -> Scenario {
     emotional_state.trust = 0.6;
     steps.push(InteractionStep {
         description: "Player approaches and waves hello".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Greeting,
-            confidence: 1.0,
-            raw_input: "Hello there!".to_string(),
-            keywords: vec!["hello".to_string(), "greeting".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Greeting,
+            1.0,
+            "Hello there!",
+            vec!["hello".to_string(), "greeting".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "friendly".to_string(),
     });
@@ -73,12 +73,12 @@ fn create_peaceful_scenario() -> Scenario {
     emotional_state.anticipation = 0.4;
     steps.push(InteractionStep {
         description: "Player asks about the village".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Question,
-            confidence: 0.9,
-            raw_input: "Can you tell me about this place?".to_string(),
-            keywords: vec!["question".to_string(), "place".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Question,
+            0.9,
+            "Can you tell me about this place?",
+            vec!["question".to_string(), "place".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "cautious".to_string(),
     });
@@ -89,12 +89,12 @@ fn create_peaceful_scenario() -> Scenario {
     emotional_state.trust = 0.7;
     steps.push(InteractionStep {
         description: "Player makes friendly conversation".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Chat,
-            confidence: 0.95,
-            raw_input: "Nice weather today, isn't it?".to_string(),
-            keywords: vec!["chat".to_string(), "friendly".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Chat,
+            0.95,
+            "Nice weather today, isn't it?",
+            vec!["chat".to_string(), "friendly".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "friendly_or_joyful".to_string(),
     });
@@ -116,12 +116,12 @@ fn create_threatening_scenario() -> Scenario {
     emotional_state.anticipation = 0.4;
     steps.push(InteractionStep {
         description: "Distant sounds of danger".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 0.7,
-            raw_input: "There's a threat nearby".to_string(),
-            keywords: vec!["threat".to_string(), "danger".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            0.7,
+            "There's a threat nearby",
+            vec!["threat".to_string(), "danger".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "cautious_or_flee".to_string(),
     });
@@ -132,12 +132,12 @@ fn create_threatening_scenario() -> Scenario {
     emotional_state.surprise = 0.3;
     steps.push(InteractionStep {
         description: "Direct threat appears".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 1.0,
-            raw_input: "A monster attacks!".to_string(),
-            keywords: vec!["attack".to_string(), "danger".to_string(), "threat".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            1.0,
+            "A monster attacks!",
+            vec!["attack".to_string(), "danger".to_string(), "threat".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "flee".to_string(),
     });
@@ -148,12 +148,12 @@ fn create_threatening_scenario() -> Scenario {
     emotional_state.surprise = 0.7;
     steps.push(InteractionStep {
         description: "Overwhelming danger".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 1.0,
-            raw_input: "The threat is coming closer!".to_string(),
-            keywords: vec!["threat".to_string(), "danger".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            1.0,
+            "The threat is coming closer!",
+            vec!["threat".to_string(), "danger".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "flee".to_string(),
     });
@@ -175,12 +175,12 @@ fn create_provocative_scenario() -> Scenario {
     emotional_state.disgust = 0.2;
     steps.push(InteractionStep {
         description: "Player makes rude comment".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 0.8,
-            raw_input: "You're not very helpful, are you?".to_string(),
-            keywords: vec!["rude".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            0.8,
+            "You're not very helpful, are you?",
+            vec!["rude".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "cautious_or_friendly".to_string(),
     });
@@ -191,12 +191,12 @@ fn create_provocative_scenario() -> Scenario {
     emotional_state.disgust = 0.4;
     steps.push(InteractionStep {
         description: "Player directly insults NPC".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 0.95,
-            raw_input: "You're pathetic!".to_string(),
-            keywords: vec!["insult".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            0.95,
+            "You're pathetic!",
+            vec!["insult".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "aggressive_or_cautious".to_string(),
     });
@@ -207,12 +207,12 @@ fn create_provocative_scenario() -> Scenario {
     emotional_state.disgust = 0.5;
     steps.push(InteractionStep {
         description: "Player issues direct challenge".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 1.0,
-            raw_input: "I challenge you to a fight!".to_string(),
-            keywords: vec!["challenge".to_string(), "provoke".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            1.0,
+            "I challenge you to a fight!",
+            vec!["challenge".to_string(), "provoke".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "aggressive".to_string(),
     });
@@ -234,12 +234,12 @@ fn create_mixed_emotions_scenario() -> Scenario {
     emotional_state.anger = 0.5;
     steps.push(InteractionStep {
         description: "Threatening but also insulting situation".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 0.8,
-            raw_input: "You're weak, and there's danger here!".to_string(),
-            keywords: vec!["insult".to_string(), "threat".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            0.8,
+            "You're weak, and there's danger here!",
+            vec!["insult".to_string(), "threat".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "flee_or_aggressive".to_string(),
     });
@@ -250,12 +250,12 @@ fn create_mixed_emotions_scenario() -> Scenario {
     emotional_state.fear = 0.3;
     steps.push(InteractionStep {
         description: "Celebration despite minor concerns".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Chat,
-            confidence: 0.9,
-            raw_input: "We won the festival!".to_string(),
-            keywords: vec!["celebration".to_string(), "happy".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Chat,
+            0.9,
+            "We won the festival!",
+            vec!["celebration".to_string(), "happy".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "joyful".to_string(),
     });
@@ -266,12 +266,12 @@ fn create_mixed_emotions_scenario() -> Scenario {
     emotional_state.anticipation = 0.6;
     steps.push(InteractionStep {
         description: "Unexpected but intriguing situation".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Question,
-            confidence: 0.85,
-            raw_input: "What's happening over there?".to_string(),
-            keywords: vec!["question".to_string(), "curious".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Question,
+            0.85,
+            "What's happening over there?",
+            vec!["question".to_string(), "curious".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "cautious".to_string(),
     });
@@ -292,12 +292,12 @@ fn create_escalation_scenario() -> Scenario {
     emotional_state.trust = 0.6;
     steps.push(InteractionStep {
         description: "Normal greeting".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Greeting,
-            confidence: 1.0,
-            raw_input: "Hello".to_string(),
-            keywords: vec!["hello".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Greeting,
+            1.0,
+            "Hello",
+            vec!["hello".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "friendly".to_string(),
     });
@@ -308,12 +308,12 @@ fn create_escalation_scenario() -> Scenario {
     emotional_state.anticipation = 0.5;
     steps.push(InteractionStep {
         description: "Tension builds".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 0.9,
-            raw_input: "I don't like your attitude".to_string(),
-            keywords: vec!["confront".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            0.9,
+            "I don't like your attitude",
+            vec!["confront".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "aggressive_or_cautious".to_string(),
     });
@@ -324,12 +324,12 @@ fn create_escalation_scenario() -> Scenario {
     emotional_state.disgust = 0.6;
     steps.push(InteractionStep {
         description: "Peak of conflict".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Custom,
-            confidence: 1.0,
-            raw_input: "How dare you insult me!".to_string(),
-            keywords: vec!["insult".to_string(), "provoke".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Custom,
+            1.0,
+            "How dare you insult me!",
+            vec!["insult".to_string(), "provoke".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "aggressive".to_string(),
     });
@@ -341,12 +341,12 @@ fn create_escalation_scenario() -> Scenario {
     emotional_state.trust = 0.2;
     steps.push(InteractionStep {
         description: "Cooling down".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Chat,
-            confidence: 0.7,
-            raw_input: "Wait, I'm sorry".to_string(),
-            keywords: vec!["apology".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Chat,
+            0.7,
+            "Wait, I'm sorry",
+            vec!["apology".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "cautious_or_friendly".to_string(),
     });
@@ -357,12 +357,12 @@ fn create_escalation_scenario() -> Scenario {
     emotional_state.joy = 0.3;
     steps.push(InteractionStep {
         description: "Resolution".to_string(),
-        intent: Intent {
-            intent_type: IntentType::Chat,
-            confidence: 0.9,
-            raw_input: "Let's start over".to_string(),
-            keywords: vec!["peace".to_string(), "friendly".to_string()],
-        },
+        intent: Intent::new(
+            IntentType::Chat,
+            0.9,
+            "Let's start over",
+            vec!["peace".to_string(), "friendly".to_string()],
+        ),
         emotional_state,
         expected_behavior_category: "friendly".to_string(),
     });
@@ -2,6 +2,13 @@
 //!
 //! Runs 10 patterns × 3 strategies × 30 turns = 900 total interactions
 //! Tracks emotional state before and after each turn for trajectory analysis
+//!
+//! Pattern×strategy cells are independent (each gets its own strategy
+//! instance and emotional state), so the sweep runs one tokio task per cell
+//! and lets the multi-thread runtime's work-stealing scheduler spread them
+//! across cores. Results stream back over a channel as cells finish and are
+//! reordered by cell coordinates at the end, so the output files match a
+//! sequential run.
 
 use crate::baselines::SelectionStrategy;
 use crate::patterns::{create_patterns, BehaviorPattern, PatternTurn};
@@ -149,38 +156,100 @@ pub struct TrajectoryStatistics {
     pub avg_emotion_persistence: f32,
 }
 
+/// Builds one strategy instance for a single pattern×strategy cell
+///
+/// Cells run on separate workers, so each builds its own instance rather
+/// than sharing one across threads; the seed lets stochastic strategies
+/// stay reproducible per cell regardless of scheduling order.
+pub type StrategyFactory = Box<dyn Fn(u64) -> Box<dyn SelectionStrategy> + Send + Sync>;
+
+/// Derive a stable per-cell RNG seed from the cell's coordinates
+///
+/// Seeding by (pattern, strategy) rather than by execution order keeps a
+/// cell's random draws identical whether the sweep runs sequentially, on
+/// 32 workers, or as a partial re-run of a few cells.
+pub fn cell_seed(pattern_name: &str, strategy_index: usize) -> u64 {
+    use std::hash::{Hash, Hasher};
+
+    let mut hasher = std::collections::hash_map::DefaultHasher::new();
+    pattern_name.hash(&mut hasher);
+    strategy_index.hash(&mut hasher);
+    hasher.finish()
+}
+
 /// Run complete trajectory study
 pub async fn run_trajectory_study(
-    strategies: Vec<Box<dyn SelectionStrategy>>,
+    strategies: Vec<StrategyFactory>,
     behaviors: Vec<Arc<dyn Behavior>>,
 ) -> Result<(Vec<TrajectoryTurnResult>, Vec<TrajectoryStatistics>)> {
     let patterns = create_patterns();
-    let context = HashMap::new();
-
-    let mut all_results = Vec::new();
+    let strategy_count = strategies.len();
+    let total_cells = patterns.len() * strategy_count;
+    let strategies = Arc::new(strategies);
+    let behaviors = Arc::new(behaviors);
 
     println!("\n==================================================");
     println!("EXTENDED TRAJECTORY STUDY");
     println!("10 patterns × 3 strategies × 30 turns = 900 interactions");
     println!("==================================================\n");
 
-    // Run each pattern through each strategy
-    for pattern in &patterns {
-        println!("Running pattern: {}", pattern.name);
-
-        for strategy in &strategies {
-            println!("  Strategy: {}", strategy.name());
-
-            let results = run_pattern(
-                pattern,
-                strategy.as_ref(),
-                &behaviors,
-                &context,
-            ).await?;
-
-            all_results.extend(results);
+    // One task per pattern×strategy cell: cells share no mutable state, so
+    // the runtime's work-stealing scheduler balances them across cores and
+    // a slow cell never blocks the rest of the sweep
+    let (result_tx, mut result_rx) = tokio::sync::mpsc::unbounded_channel();
+    for (pattern_index, pattern) in patterns.into_iter().enumerate() {
+        let pattern = Arc::new(pattern);
+        for strategy_index in 0..strategy_count {
+            let pattern = Arc::clone(&pattern);
+            let strategies = Arc::clone(&strategies);
+            let behaviors = Arc::clone(&behaviors);
+            let result_tx = result_tx.clone();
+
+            tokio::spawn(async move {
+                let strategy = strategies[strategy_index](cell_seed(&pattern.name, strategy_index));
+                let context = HashMap::new();
+                let outcome = run_pattern(&pattern, strategy.as_ref(), &behaviors, &context).await;
+                let _ = result_tx.send((
+                    pattern_index,
+                    strategy_index,
+                    pattern.name.clone(),
+                    strategy.name().to_string(),
+                    outcome,
+                ));
+            });
         }
     }
+    drop(result_tx);
+
+    // Stream cells as they finish; a failed cell is logged and skipped so
+    // a partial sweep still yields usable data
+    let mut cells: Vec<(usize, usize, Vec<TrajectoryTurnResult>)> = Vec::with_capacity(total_cells);
+    let mut completed = 0;
+    while let Some((pattern_index, strategy_index, pattern_name, strategy_name, outcome)) =
+        result_rx.recv().await
+    {
+        completed += 1;
+        match outcome {
+            Ok(results) => {
+                println!(
+                    "  [{}/{}] {} × {}: {} turns",
+                    completed, total_cells, pattern_name, strategy_name, results.len()
+                );
+                cells.push((pattern_index, strategy_index, results));
+            }
+            Err(e) => {
+                log::warn!("Cell {} × {} failed: {}", pattern_name, strategy_name, e);
+            }
+        }
+    }
+
+    // Reorder the flattened results by cell coordinates so output files are
+    // identical to a sequential run
+    cells.sort_by_key(|cell| (cell.0, cell.1));
+    let mut all_results = Vec::new();
+    for (_, _, results) in cells {
+        all_results.extend(results);
+    }
 
     println!("\n✓ Completed {} total interactions\n", all_results.len());
 
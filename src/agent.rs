@@ -10,9 +10,9 @@ use regex::RegexSet;
 use tokio::sync::RwLock;
 use uuid::Uuid;
 
-use crate::audio::{AudioData, TTSError, TTSService};
+use crate::audio::{AudioData, SpeechPipeline, TTSError, TTSService};
 use crate::config::AgentConfig;
-use crate::inference::InferenceEngine;
+use crate::inference::{ChunkHandler, InferenceEngine};
 use crate::memory::{Memory, MemoryCategory, MemorySystem};
 use crate::oxyde_game::behavior::{Behavior, BehaviorResult};
 use crate::oxyde_game::emotion::EmotionalState;
@@ -22,6 +22,14 @@ use crate::Result;
 // Re-export AgentContext from oxyde-core so it's available as agent::AgentContext
 pub use crate::AgentContext;
 
+/// Importance assigned to stored conversation turns (player inputs and
+/// generated responses)
+///
+/// Deliberately below 1.0: `Memory::new` treats importance >= 1.0 as
+/// permanent, and permanent memories bypass the episodic ring, per-category
+/// budgets, and consolidation. Conversation history has to stay evictable.
+const CONVERSATION_TURN_IMPORTANCE: f64 = 0.8;
+
 /// Callback for agent events
 pub type AgentCallback = Box<dyn Fn(&Agent, &str) + Send + Sync>;
 
@@ -46,6 +54,23 @@ impl CallbackWrapper {
     }
 }
 
+/// Immutable snapshot of registered callbacks
+///
+/// Registration rebuilds the snapshot and swaps the `Arc`; dispatch clones
+/// the `Arc` and invokes callbacks without holding any lock, so a slow or
+/// re-entrant callback can never stall registration or other dispatchers.
+type CallbackSnapshot = HashMap<String, Vec<Arc<CallbackWrapper>>>;
+
+/// An event captured on the hot path, delivered on the next pump
+#[derive(Debug)]
+struct QueuedEvent {
+    /// Event name (see [`AgentEvent::as_str`])
+    event: String,
+
+    /// Event payload
+    data: String,
+}
+
 /// Agent state
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum AgentState {
@@ -78,6 +103,8 @@ pub enum AgentEvent {
     Action,
     /// Agent has generated a response
     Response,
+    /// Agent has produced a chunk of a streamed response
+    ResponseChunk,
     /// Agent state has changed
     StateChange,
     /// Agent encountered an error
@@ -92,6 +119,7 @@ impl AgentEvent {
             Self::Stop => "stop",
             Self::Action => "action",
             Self::Response => "response",
+            Self::ResponseChunk => "response_chunk",
             Self::StateChange => "state_change",
             Self::Error => "error",
         }
@@ -104,6 +132,7 @@ impl AgentEvent {
             "stop" => Some(Self::Stop),
             "action" => Some(Self::Action),
             "response" => Some(Self::Response),
+            "response_chunk" | "responsechunk" => Some(Self::ResponseChunk),
             "state_change" | "statechange" => Some(Self::StateChange),
             "error" => Some(Self::Error),
             _ => None,
@@ -146,14 +175,25 @@ pub struct Agent {
     /// TTS service for generating speech
     tts_service: Option<Arc<TTSService>>,
 
-    /// Callbacks for agent events
-    callbacks: Mutex<HashMap<String, Vec<CallbackWrapper>>>,
+    /// Callbacks for agent events; the lock guards only the snapshot swap
+    /// on registration, never callback execution
+    callbacks: Mutex<Arc<CallbackSnapshot>>,
+
+    /// Producer side of the event queue; triggering an event costs one
+    /// enqueue on the processing path
+    event_tx: tokio::sync::mpsc::UnboundedSender<QueuedEvent>,
+
+    /// Consumer side of the event queue, drained by [`Agent::pump_events`]
+    event_rx: Mutex<tokio::sync::mpsc::UnboundedReceiver<QueuedEvent>>,
+
+    /// Whether the background event dispatcher has been started
+    event_dispatcher_started: std::sync::atomic::AtomicBool,
 
     /// Emotional state of the agent
     emotional_state: RwLock<EmotionalState>,
 
     /// Moderation patterns for content filtering
-    moderation_patterns: Option<RegexSet>,
+    moderation_patterns: Option<Arc<RegexSet>>,
 }
 
 impl Agent {
@@ -170,13 +210,16 @@ impl Agent {
         let inference = Arc::new(InferenceEngine::new(&config.inference));
         let memory = Arc::new(MemorySystem::new(config.memory.clone()));
 
-        // Load moderation patterns if enabled
+        // Load moderation patterns if enabled; the compiled set is shared
+        // process-wide, so only the first agent pays the compilation cost
         let moderation_patterns = if config.moderation.enabled {
-            crate::utils::load_moderation_patterns("assets/badwords_regex.txt").ok()
+            crate::utils::shared_moderation_patterns("assets/badwords_regex.txt").ok()
         } else {
             None
         };
 
+        let (event_tx, event_rx) = tokio::sync::mpsc::unbounded_channel();
+
         Self {
             id: Uuid::new_v4(),
             name: config.agent.name.clone(),
@@ -187,7 +230,10 @@ impl Agent {
             tts_service: None, // TTS service is optional ..... REMOVE IF TTS WILL ALWAYS BE REQUIRED
             context: RwLock::new(HashMap::new()),
             behaviors: RwLock::new(Vec::new()),
-            callbacks: Mutex::new(HashMap::new()),
+            callbacks: Mutex::new(Arc::new(HashMap::new())),
+            event_tx,
+            event_rx: Mutex::new(event_rx),
+            event_dispatcher_started: std::sync::atomic::AtomicBool::new(false),
             emotional_state: RwLock::new(EmotionalState::new()),
             moderation_patterns,
         }
@@ -199,7 +245,7 @@ impl Agent {
         let memory = Arc::new(MemorySystem::new(config.memory.clone()));
 
         let moderation_patterns = if config.moderation.enabled {
-            crate::utils::load_moderation_patterns("assets/badwords_regex.txt").ok()
+            crate::utils::shared_moderation_patterns("assets/badwords_regex.txt").ok()
         } else {
             None
         };
@@ -212,6 +258,8 @@ impl Agent {
             ))
         });
 
+        let (event_tx, event_rx) = tokio::sync::mpsc::unbounded_channel();
+
         Self {
             id: Uuid::new_v4(),
             name: config.agent.name.clone(),
@@ -222,7 +270,10 @@ impl Agent {
             tts_service, // Add TTS service field
             context: RwLock::new(HashMap::new()),
             behaviors: RwLock::new(Vec::new()),
-            callbacks: Mutex::new(HashMap::new()),
+            callbacks: Mutex::new(Arc::new(HashMap::new())),
+            event_tx,
+            event_rx: Mutex::new(event_rx),
+            event_dispatcher_started: std::sync::atomic::AtomicBool::new(false),
             emotional_state: RwLock::new(EmotionalState::new()),
             moderation_patterns,
         }
@@ -234,7 +285,7 @@ impl Agent {
         text: &str,
         emotions: &EmotionalState,
         urgency: f32,
-    ) -> Result<AudioData> {
+    ) -> Result<Arc<AudioData>> {
         if let Some(tts) = &self.tts_service {
             tts.synthesize_npc_speech(&self.name, text, emotions, urgency)
                 .await
@@ -294,6 +345,14 @@ impl Agent {
         state.decay();
     }
 
+    /// Get direct access to the emotional state cell
+    ///
+    /// Used by the scheduler to batch lock acquisition across a pool of
+    /// agents instead of locking per agent per call.
+    pub(crate) fn emotional_state_cell(&self) -> &RwLock<EmotionalState> {
+        &self.emotional_state
+    }
+
     /// Get the current emotional valence (-1.0 to 1.0)
     ///
     /// Valence represents how positive or negative the agent feels
@@ -314,18 +373,23 @@ impl Agent {
     ///
     /// * `behavior` - A behavior to add to the agent
     pub async fn add_behavior<B: Behavior + 'static>(&self, behavior: B) {
-        let mut behaviors = self.behaviors.write().await;
-        behaviors.push(Box::new(behavior));
+        self.add_boxed_behavior(Box::new(behavior)).await;
     }
 
     /// Add a boxed behavior to the agent
     ///
+    /// The behavior list is kept sorted by base priority (highest first) at
+    /// insertion time, so dispatch in `process_input` does not re-sort it on
+    /// every input.
+    ///
     /// # Arguments
     ///
     /// * `behavior` - A boxed behavior to add to the agent
     pub async fn add_boxed_behavior(&self, behavior: Box<dyn Behavior>) {
         let mut behaviors = self.behaviors.write().await;
-        behaviors.push(behavior);
+        let priority = behavior.priority();
+        let slot = behaviors.partition_point(|b| b.priority() >= priority);
+        behaviors.insert(slot, behavior);
     }
 
     /// Update the agent's context with new data
@@ -358,11 +422,89 @@ impl Agent {
             ))
             .await?;
 
+        // Embed memories off the hot path so process_input never waits on
+        // the embedding model
+        #[cfg(feature = "vector-memory")]
+        if self.config.memory.use_embeddings {
+            self.memory.start_embedding_worker(100);
+        }
+
+        // Fold aged low-importance episodic memories into compact semantic
+        // summaries so long-lived NPCs keep a bounded footprint
+        self.memory.start_consolidation_worker(60_000);
+
+        // Pre-synthesize fixed behavior lines in the background so their
+        // first playback is a cache hit instead of a network round trip
+        self.spawn_audio_prefetch().await;
+
         self.trigger_event(AgentEvent::Start, "Agent started").await;
 
         Ok(())
     }
 
+    /// Pre-synthesize audio for fixed behavior responses
+    ///
+    /// Collects the canned response strings advertised by registered
+    /// behaviors (see [`Behavior::canned_responses`]) and synthesizes each
+    /// one into the TTS cache, so spoken playback of those lines never waits
+    /// on the synthesis provider.
+    ///
+    /// # Returns
+    ///
+    /// The number of lines successfully synthesized into the cache
+    pub async fn prefetch_behavior_audio(&self) -> usize {
+        let tts = match &self.tts_service {
+            Some(tts) => Arc::clone(tts),
+            None => return 0,
+        };
+
+        let emotions = self.emotional_state.read().await.clone();
+        let lines = self.collect_canned_responses().await;
+
+        let mut prefetched = 0;
+        for line in lines {
+            match tts
+                .synthesize_npc_speech(&self.name, &line, &emotions, 0.5)
+                .await
+            {
+                Ok(_) => prefetched += 1,
+                Err(e) => log::warn!("Failed to prefetch audio for '{}': {}", line, e),
+            }
+        }
+        prefetched
+    }
+
+    async fn collect_canned_responses(&self) -> Vec<String> {
+        let behaviors = self.behaviors.read().await;
+        behaviors
+            .iter()
+            .flat_map(|b| b.canned_responses())
+            .collect()
+    }
+
+    /// Kick off behavior audio prefetch on a background task
+    async fn spawn_audio_prefetch(&self) {
+        let tts = match &self.tts_service {
+            Some(tts) => Arc::clone(tts),
+            None => return,
+        };
+
+        let lines = self.collect_canned_responses().await;
+        if lines.is_empty() {
+            return;
+        }
+
+        let name = self.name.clone();
+        let emotions = self.emotional_state.read().await.clone();
+        tokio::spawn(async move {
+            for line in lines {
+                if let Err(e) = tts.synthesize_npc_speech(&name, &line, &emotions, 0.5).await {
+                    log::warn!("Failed to prefetch audio for '{}': {}", line, e);
+                }
+            }
+        });
+    }
+
     /// Stop the agent
     pub async fn stop(&self) -> Result<()> {
         let mut state = self.state.write().await;
@@ -388,9 +530,10 @@ impl Agent {
             return None;
         }
 
-        // Quick regex check first (instant)
+        // Quick regex check first (instant); patterns are compiled
+        // case-insensitively, so the raw input is scanned without copying
         let regex_flagged = if let Some(ref patterns) = self.moderation_patterns {
-            patterns.is_match(&input.to_lowercase())
+            patterns.is_match(input)
         } else {
             false
         };
@@ -436,6 +579,56 @@ impl Agent {
     ///
     /// A result containing the agent's response
     pub async fn process_input(&self, input: &str) -> Result<String> {
+        self.process_input_inner(input, None).await
+    }
+
+    /// Process player input and speak the response as it is generated
+    ///
+    /// Unlike calling [`process_input`](Self::process_input) followed by
+    /// [`speak`](Self::speak), which synthesizes audio only after the full
+    /// text exists, this streams the response through a sentence-level
+    /// pipeline: each completed sentence starts TTS synthesis while later
+    /// sentences are still generating, overlapping inference and synthesis.
+    ///
+    /// # Arguments
+    ///
+    /// * `input` - Player input to process
+    /// * `urgency` - Urgency level applied to the synthesized speech
+    ///
+    /// # Returns
+    ///
+    /// The full text response together with one audio clip per sentence,
+    /// in sentence order
+    pub async fn process_input_spoken(
+        &self,
+        input: &str,
+        urgency: f32,
+    ) -> Result<(String, Vec<Arc<AudioData>>)> {
+        let tts = self.tts_service.as_ref().ok_or_else(|| {
+            crate::OxydeError::ConfigurationError("TTS not configured".to_string())
+        })?;
+
+        let emotions = self.emotional_state.read().await.clone();
+        let pipeline = SpeechPipeline::new(Arc::clone(tts), self.name.clone(), emotions, urgency);
+
+        let on_sentence_text = |chunk: &str| pipeline.push(chunk);
+        let response = self
+            .process_input_inner(input, Some(&on_sentence_text))
+            .await?;
+
+        let audio = pipeline.finish().await.map_err(|e| {
+            crate::OxydeError::AudioError(TTSError::AudioProcessingError(e.to_string()))
+        })?;
+
+        Ok((response, audio))
+    }
+
+    async fn process_input_inner(
+        &self,
+        input: &str,
+        text_sink: Option<&ChunkHandler<'_>>,
+    ) -> Result<String> {
+        let started = std::time::Instant::now();
         {
             let mut state = self.state.write().await;
             *state = AgentState::Processing;
@@ -449,19 +642,28 @@ impl Agent {
                 let mut state = self.state.write().await;
                 *state = AgentState::Idle;
             }
+            if let Some(sink) = text_sink {
+                sink(&moderation_response);
+            }
             self.trigger_callback("response", &moderation_response).await;
+            crate::metrics::global().moderation_blocks.increment();
+            crate::metrics::global().process_input.record(started.elapsed());
             return Ok(moderation_response);
         }
 
         // Analyze player intent
         let intent = Intent::analyze(input).await?;
 
-        // Update memory with player input, capturing current emotional state
+        // Update memory with player input, capturing current emotional
+        // state. Conversation turns stay below importance 1.0 so they never
+        // become permanent: permanent memories are exempt from the episodic
+        // ring, category budgets, and consolidation, and dialogue history
+        // must remain evictable or it grows without bound.
         let emotional_state = self.emotional_state.read().await;
         self.memory.add(Memory::new_emotional(
                 MemoryCategory::Episodic,
                 input,
-                1.0,
+                CONVERSATION_TURN_IMPORTANCE,
                 emotional_state.valence() as f64,
                 emotional_state.arousal() as f64,
                 None
@@ -479,7 +681,10 @@ impl Agent {
         // Get current emotional state for behavior filtering and prioritization
         let current_emotional_state = self.emotional_state.read().await.clone();
 
-        // Filter and sort behaviors by priority (considering emotional modifiers)
+        let dispatch_started = std::time::Instant::now();
+
+        // Filter behaviors by emotion trigger; the list is already sorted by
+        // base priority at insertion (see add_boxed_behavior)
         let mut candidate_behaviors: Vec<_> = behaviors
             .iter()
             .filter(|b| {
@@ -492,18 +697,29 @@ impl Agent {
             })
             .collect();
 
-        // Sort by priority (base + emotional modifier), highest first
-        candidate_behaviors.sort_by(|a, b| {
-            let a_priority = a.priority() as i32 + a.emotional_priority_modifier(&current_emotional_state);
-            let b_priority = b.priority() as i32 + b.emotional_priority_modifier(&current_emotional_state);
-            b_priority.cmp(&a_priority) // Descending order
-        });
+        // Only re-sort when the current emotional state actually modulates
+        // some candidate's priority; with all modifiers at zero the
+        // insertion order already is the dispatch order
+        if candidate_behaviors
+            .iter()
+            .any(|b| b.emotional_priority_modifier(&current_emotional_state) != 0)
+        {
+            // Sort by priority (base + emotional modifier), highest first
+            candidate_behaviors.sort_by(|a, b| {
+                let a_priority = a.priority() as i32 + a.emotional_priority_modifier(&current_emotional_state);
+                let b_priority = b.priority() as i32 + b.emotional_priority_modifier(&current_emotional_state);
+                b_priority.cmp(&a_priority) // Descending order
+            });
+        }
+
+        // Behaviors take the context by shared reference; holding the read
+        // guard across the loop avoids cloning the map per execution
+        let shared_context = self.context.read().await;
 
         // Execute matching behaviors in priority order
         for behavior in candidate_behaviors {
             if behavior.matches_intent(&intent).await {
-                let context = self.context.read().await.clone();
-                let behavior_result = behavior.execute(&intent, &context).await?;
+                let behavior_result = behavior.execute(&intent, &shared_context).await?;
 
                 // Apply emotional influences from the behavior
                 let influences = behavior.emotion_influences();
@@ -516,6 +732,13 @@ impl Agent {
 
                 match behavior_result {
                     BehaviorResult::Response(text) => {
+                        // Behavior responses arrive whole; fixed lines are
+                        // usually already pre-synthesized in the TTS cache
+                        // (see prefetch_behavior_audio), so the sink's
+                        // synthesis is a cache hit
+                        if let Some(sink) = text_sink {
+                            sink(&text);
+                        }
                         response = text;
                         break;
                     }
@@ -530,6 +753,12 @@ impl Agent {
             }
         }
 
+        drop(shared_context);
+
+        crate::metrics::global()
+            .behavior_dispatch
+            .record(dispatch_started.elapsed());
+
         // If no behavior provided a response, generate one with inference
         if response.is_empty() {
             {
@@ -540,19 +769,44 @@ impl Agent {
             // Get relevant memories
             let memories = self.memory.retrieve_relevant(input, 5, None).await?;
 
-            // Generate response using inference engine
-            let context = self.context.read().await.clone();
-            response = self
-                .inference
-                .generate_response(input, &memories, &context)
-                .await?;
-
-            // Store the response in memory with current emotional state
+            // Generate response using inference engine; when a chunk
+            // listener is registered, stream the text through it so callers
+            // see output as it arrives instead of waiting for the full
+            // completion
+            let mut context = self.context.read().await.clone();
+
+            // Key the local provider's per-conversation prefill cache by
+            // agent id, so multi-turn dialogue only pays for the part of the
+            // prompt that changed since the last turn
+            context.insert(
+                "conversation_id".to_string(),
+                serde_json::Value::String(self.id.to_string()),
+            );
+
+            response = if text_sink.is_some() || self.has_event_listeners(AgentEvent::ResponseChunk) {
+                let on_chunk = |chunk: &str| {
+                    self.trigger_callback_sync(AgentEvent::ResponseChunk.as_str(), chunk);
+                    if let Some(sink) = text_sink {
+                        sink(chunk);
+                    }
+                };
+                self.inference
+                    .generate_response_stream(input, &memories, &context, &on_chunk)
+                    .await?
+            } else {
+                self.inference
+                    .generate_response(input, &memories, &context)
+                    .await?
+            };
+
+            // Store the response in memory with current emotional state,
+            // again below the permanence threshold so responses stay subject
+            // to budgets and consolidation
             let emotional_state = self.emotional_state.read().await;
             self.memory.add(Memory::new_emotional(
                 MemoryCategory::Semantic,
                 &response,
-                1.0,
+                CONVERSATION_TURN_IMPORTANCE,
                 emotional_state.valence() as f64,
                 emotional_state.arousal() as f64,
                 None
@@ -568,6 +822,8 @@ impl Agent {
         // Trigger response callback
         self.trigger_event(AgentEvent::Response, &response).await;
 
+        crate::metrics::global().process_input.record(started.elapsed());
+
         Ok(response)
     }
 
@@ -603,13 +859,30 @@ impl Agent {
     where
         F: Fn(&Agent, &str) + Send + Sync + 'static,
     {
-        // Lock the callbacks mutex, recovering from poison if necessary
+        // Rebuild the snapshot and swap it in; dispatchers holding the old
+        // snapshot finish their pass against it and pick up the new callback
+        // on their next event
         let mut callbacks = self.callbacks.lock().unwrap_or_else(|poisoned| {
             log::warn!("Callback mutex was poisoned, recovering");
             poisoned.into_inner()
         });
-        let event_callbacks = callbacks.entry(event.to_string()).or_insert(Vec::new());
-        event_callbacks.push(CallbackWrapper::new(Box::new(callback)));
+        let mut next: CallbackSnapshot = (**callbacks).clone();
+        next.entry(event.to_string())
+            .or_insert(Vec::new())
+            .push(Arc::new(CallbackWrapper::new(Box::new(callback))));
+        *callbacks = Arc::new(next);
+    }
+
+    /// Clone the current callback snapshot
+    ///
+    /// The lock is held only for the `Arc` clone, so dispatch never blocks
+    /// on registration (or vice versa) for longer than that.
+    fn callback_snapshot(&self) -> Arc<CallbackSnapshot> {
+        let callbacks = self.callbacks.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Callback mutex was poisoned, recovering");
+            poisoned.into_inner()
+        });
+        Arc::clone(&callbacks)
     }
 
     /// Trigger a callback for a typed event
@@ -622,25 +895,138 @@ impl Agent {
         self.trigger_callback(event.as_str(), data).await;
     }
 
-    /// Trigger a callback for an event
+    /// Queue an event for delivery
+    ///
+    /// The processing path pays one enqueue here; callbacks run later, when
+    /// the host drains the queue via [`Agent::pump_events`] or the
+    /// background dispatcher (see [`Agent::start_event_dispatcher`]). A slow
+    /// game-side callback therefore never stalls `process_input`.
+    ///
+    /// Events with no registered listener are dropped rather than queued:
+    /// hosts that never register callbacks (the engine FFI bindings poll
+    /// responses directly) would otherwise accumulate one undrained event
+    /// per interaction for the life of the process.
     ///
     /// # Arguments
     ///
     /// * `event` - Event name
     /// * `data` - Event data
     async fn trigger_callback(&self, event: &str, data: &str) {
-        // Lock the callbacks mutex, recovering from poison if necessary
-        let callbacks = self.callbacks.lock().unwrap_or_else(|poisoned| {
-            log::warn!("Callback mutex was poisoned during trigger, recovering");
-            poisoned.into_inner()
+        if !self.has_listeners_for(event) {
+            return;
+        }
+
+        // Send on an unbounded channel only fails when the receiver is
+        // gone, which cannot happen while the agent owns it
+        let _ = self.event_tx.send(QueuedEvent {
+            event: event.to_string(),
+            data: data.to_string(),
         });
-        if let Some(event_callbacks) = callbacks.get(event) {
+    }
+
+    /// Deliver an event to its listeners immediately
+    ///
+    /// Used by the streaming path, where response chunks must reach
+    /// listeners in real time rather than on the next pump. Dispatch runs
+    /// against a snapshot, outside any lock.
+    fn trigger_callback_sync(&self, event: &str, data: &str) {
+        let snapshot = self.callback_snapshot();
+        if let Some(event_callbacks) = snapshot.get(event) {
             for callback in event_callbacks {
                 callback.call(self, data);
             }
         }
     }
 
+    /// Deliver all queued events to their registered callbacks
+    ///
+    /// Engines that own their threading call this from their own update
+    /// loop (for example once per frame), so callbacks run on the thread the
+    /// game expects. Hosts without an update loop can start the background
+    /// dispatcher instead (see [`Agent::start_event_dispatcher`]); the two
+    /// are alternatives, not complements.
+    ///
+    /// # Returns
+    ///
+    /// Number of events delivered in this pass
+    pub fn pump_events(&self) -> usize {
+        // Drain the queue first and drop the receiver lock before invoking
+        // anything, so a callback may itself trigger or pump events
+        let drained: Vec<QueuedEvent> = {
+            let mut event_rx = self.event_rx.lock().unwrap_or_else(|poisoned| {
+                log::warn!("Event queue mutex was poisoned, recovering");
+                poisoned.into_inner()
+            });
+            let mut drained = Vec::new();
+            while let Ok(event) = event_rx.try_recv() {
+                drained.push(event);
+            }
+            drained
+        };
+
+        if drained.is_empty() {
+            return 0;
+        }
+
+        let snapshot = self.callback_snapshot();
+        let delivered = drained.len();
+        for queued in drained {
+            if let Some(event_callbacks) = snapshot.get(&queued.event) {
+                for callback in event_callbacks {
+                    callback.call(self, &queued.data);
+                }
+            }
+        }
+        delivered
+    }
+
+    /// Spawn the background event dispatcher
+    ///
+    /// The dispatcher pumps queued events every `interval_ms` and runs until
+    /// the agent is dropped. Calling this again after the dispatcher is
+    /// running is a no-op. Engines that call [`Agent::pump_events`] from
+    /// their own update loop should not start it.
+    ///
+    /// # Arguments
+    ///
+    /// * `interval_ms` - How often queued events are delivered
+    pub fn start_event_dispatcher(self: &Arc<Self>, interval_ms: u64) -> Option<tokio::task::JoinHandle<()>> {
+        use std::sync::atomic::Ordering;
+
+        if self.event_dispatcher_started.swap(true, Ordering::SeqCst) {
+            return None;
+        }
+
+        // Hold only a weak reference so the dispatcher never keeps a
+        // despawned agent alive
+        let agent = Arc::downgrade(self);
+        Some(tokio::spawn(async move {
+            let mut interval = tokio::time::interval(std::time::Duration::from_millis(interval_ms));
+            loop {
+                interval.tick().await;
+                match agent.upgrade() {
+                    Some(agent) => {
+                        agent.pump_events();
+                    }
+                    None => break,
+                }
+            }
+        }))
+    }
+
+    /// Check whether any callbacks are registered for an event
+    fn has_event_listeners(&self, event: AgentEvent) -> bool {
+        self.has_listeners_for(event.as_str())
+    }
+
+    /// Check whether any callbacks are registered for an event by name
+    fn has_listeners_for(&self, event: &str) -> bool {
+        self.callback_snapshot()
+            .get(event)
+            .map(|listeners| !listeners.is_empty())
+            .unwrap_or(false)
+    }
+
 
     /// Create a new agent with the same configuration but new state
     ///
@@ -724,13 +1110,21 @@ impl Agent {
     pub async fn get_memory(&self, memory_id: &str) -> Option<Memory> {
         self.memory.get(memory_id).await
     }
+
+    /// Save all memories to a binary snapshot file
+    pub async fn save_memory_snapshot(&self, path: &str) -> Result<usize> {
+        self.memory.save_snapshot(std::path::Path::new(path)).await
+    }
+
+    /// Load memories from a binary snapshot file, replacing current contents
+    pub async fn load_memory_snapshot(&self, path: &str) -> Result<usize> {
+        self.memory.load_snapshot(std::path::Path::new(path)).await
+    }
 }
 
 impl std::fmt::Debug for Agent {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        let callbacks_count = self.callbacks.lock()
-            .map(|cb| cb.len())
-            .unwrap_or(0);
+        let callbacks_count = self.callback_snapshot().len();
 
         f.debug_struct("Agent")
             .field("id", &self.id)
@@ -788,6 +1182,114 @@ impl AgentBuilder {
     }
 }
 
+/// AgentFactory stamps out agents from a shared prototype
+///
+/// `Agent::new` resolves moderation patterns and builds a private inference
+/// engine for every agent, so spawning a crowd of NPCs at level load repeats
+/// the same setup work per agent. The factory resolves those resources once
+/// from a prototype configuration; `spawn` then only allocates per-agent
+/// state (memory, context, emotions) and runs in microseconds.
+///
+/// Agents spawned from one factory share a single inference engine, which
+/// also means they share its response cache and batching queue.
+pub struct AgentFactory {
+    /// Prototype configuration cloned into every spawned agent
+    config: AgentConfig,
+
+    /// Inference engine shared by all spawned agents
+    inference: Arc<InferenceEngine>,
+
+    /// TTS service shared by all spawned agents, if configured
+    tts_service: Option<Arc<TTSService>>,
+
+    /// Moderation pattern set shared by all spawned agents, if enabled
+    moderation_patterns: Option<Arc<RegexSet>>,
+}
+
+impl AgentFactory {
+    /// Create a factory from a prototype configuration
+    ///
+    /// This pays the one-time resource costs (inference engine construction,
+    /// moderation pattern compilation, TTS setup) up front.
+    ///
+    /// # Arguments
+    ///
+    /// * `config` - Prototype configuration for spawned agents
+    ///
+    /// # Returns
+    ///
+    /// A new AgentFactory instance
+    pub fn new(config: AgentConfig) -> Self {
+        let inference = Arc::new(InferenceEngine::new(&config.inference));
+
+        let moderation_patterns = if config.moderation.enabled {
+            crate::utils::shared_moderation_patterns("assets/badwords_regex.txt").ok()
+        } else {
+            None
+        };
+
+        let tts_service = config.tts.as_ref().map(|tts_config| {
+            Arc::new(TTSService::new(
+                tts_config.default_provider.clone(),
+                tts_config.clone(),
+            ))
+        });
+
+        Self {
+            config,
+            inference,
+            tts_service,
+            moderation_patterns,
+        }
+    }
+
+    /// Spawn a new agent from the prototype
+    ///
+    /// The agent gets a fresh identity, memory system, and emotional state
+    /// while borrowing the factory's shared resources.
+    ///
+    /// # Returns
+    ///
+    /// A new Agent instance
+    pub fn spawn(&self) -> Agent {
+        self.spawn_named(&self.config.agent.name)
+    }
+
+    /// Spawn a new agent from the prototype with a different name
+    ///
+    /// Useful when populating a crowd of NPCs that share one configuration
+    /// but need distinct display names.
+    ///
+    /// # Arguments
+    ///
+    /// * `name` - Name for the spawned agent
+    ///
+    /// # Returns
+    ///
+    /// A new Agent instance
+    pub fn spawn_named(&self, name: &str) -> Agent {
+        let (event_tx, event_rx) = tokio::sync::mpsc::unbounded_channel();
+
+        Agent {
+            id: Uuid::new_v4(),
+            name: name.to_string(),
+            config: self.config.clone(),
+            state: RwLock::new(AgentState::Initializing),
+            inference: Arc::clone(&self.inference),
+            memory: Arc::new(MemorySystem::new(self.config.memory.clone())),
+            tts_service: self.tts_service.clone(),
+            context: RwLock::new(HashMap::new()),
+            behaviors: RwLock::new(Vec::new()),
+            callbacks: Mutex::new(Arc::new(HashMap::new())),
+            event_tx,
+            event_rx: Mutex::new(event_rx),
+            event_dispatcher_started: std::sync::atomic::AtomicBool::new(false),
+            emotional_state: RwLock::new(EmotionalState::new()),
+            moderation_patterns: self.moderation_patterns.clone(),
+        }
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -878,6 +1380,34 @@ mod tests {
         }
     }
 
+    #[tokio::test]
+    async fn test_factory_spawns_distinct_agents_with_shared_engine() {
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Villager".to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig::default(),
+            behavior: HashMap::new(),
+            moderation: crate::config::ModerationConfig::default(),
+            tts: None, // No TTS for this test
+        };
+
+        let factory = AgentFactory::new(config);
+        let first = factory.spawn();
+        let second = factory.spawn_named("Villager 2");
+
+        assert_ne!(first.id(), second.id(), "Spawned agents should get fresh identities");
+        assert_eq!(first.name(), "Villager");
+        assert_eq!(second.name(), "Villager 2");
+
+        // The expensive resources are shared, not rebuilt per spawn
+        assert!(Arc::ptr_eq(&first.inference, &second.inference));
+    }
+
     #[tokio::test]
     async fn test_content_moderation() {
         let config = AgentConfig {
@@ -906,4 +1436,253 @@ mod tests {
         let response = agent.process_input("Fuck you").await.unwrap();
         assert_eq!(response, "Sorry, I can't respond to that.");
     }
+
+    #[tokio::test]
+    async fn test_response_chunk_events_stream_generated_text() {
+        use std::sync::{Arc, Mutex as StdMutex};
+
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Streaming Agent".to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig {
+                use_local: true,
+                local_model_path: Some("test-model".to_string()),
+                ..Default::default()
+            },
+            behavior: HashMap::new(),
+            moderation: crate::config::ModerationConfig::default(),
+            tts: None,
+        };
+
+        let agent = Agent::new(config);
+        agent.start().await.unwrap();
+
+        let chunks: Arc<StdMutex<Vec<String>>> = Arc::new(StdMutex::new(Vec::new()));
+        let sink = chunks.clone();
+        agent.on_event(AgentEvent::ResponseChunk, move |_, chunk| {
+            sink.lock().unwrap().push(chunk.to_string());
+        });
+
+        let response = agent.process_input("Tell me a story").await.unwrap();
+
+        // With a chunk listener registered the response arrives incrementally,
+        // and the chunks reassemble into the returned text
+        let chunks = chunks.lock().unwrap();
+        assert!(chunks.len() > 1);
+        assert_eq!(chunks.concat(), response);
+    }
+
+    #[tokio::test]
+    async fn test_events_are_queued_until_pumped() {
+        use std::sync::{Arc, Mutex as StdMutex};
+
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Queued Agent".to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig {
+                use_local: true,
+                local_model_path: Some("test-model".to_string()),
+                ..Default::default()
+            },
+            behavior: HashMap::new(),
+            moderation: crate::config::ModerationConfig::default(),
+            tts: None,
+        };
+
+        let agent = Agent::new(config);
+
+        let responses: Arc<StdMutex<Vec<String>>> = Arc::new(StdMutex::new(Vec::new()));
+        let sink = responses.clone();
+        agent.on_event(AgentEvent::Response, move |_, data| {
+            sink.lock().unwrap().push(data.to_string());
+        });
+
+        agent.start().await.unwrap();
+        let response = agent.process_input("Hello there").await.unwrap();
+
+        // Processing only enqueued the event; no callback has run yet
+        assert!(responses.lock().unwrap().is_empty());
+
+        // Pumping delivers the queued response event; events nothing
+        // listens for (start, action) were never enqueued
+        assert_eq!(agent.pump_events(), 1);
+        let responses = responses.lock().unwrap();
+        assert_eq!(responses.as_slice(), &[response]);
+
+        // The queue is empty after a pump
+        assert_eq!(agent.pump_events(), 0);
+    }
+
+    #[tokio::test]
+    async fn test_events_without_listeners_are_not_queued() {
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Unwatched Agent".to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig {
+                use_local: true,
+                local_model_path: Some("test-model".to_string()),
+                ..Default::default()
+            },
+            behavior: HashMap::new(),
+            moderation: crate::config::ModerationConfig::default(),
+            tts: None,
+        };
+
+        let agent = Agent::new(config);
+
+        agent.start().await.unwrap();
+        agent.process_input("Hello there").await.unwrap();
+        agent.process_input("Still there?").await.unwrap();
+
+        // A host that registered no callbacks (the engine bindings poll
+        // responses directly) must not accumulate queued events
+        assert_eq!(agent.pump_events(), 0);
+    }
+
+    #[tokio::test]
+    async fn test_behaviors_dispatch_in_priority_order() {
+        use crate::oxyde_game::behavior::{Behavior, BehaviorResult};
+        use crate::oxyde_game::intent::Intent;
+
+        #[derive(Debug)]
+        struct FixedResponseBehavior {
+            response: &'static str,
+            priority: u32,
+        }
+
+        #[async_trait::async_trait]
+        impl Behavior for FixedResponseBehavior {
+            async fn matches_intent(&self, _intent: &Intent) -> bool {
+                true
+            }
+
+            async fn execute(
+                &self,
+                _intent: &Intent,
+                _context: &AgentContext,
+            ) -> crate::Result<BehaviorResult> {
+                Ok(BehaviorResult::Response(self.response.to_string()))
+            }
+
+            fn priority(&self) -> u32 {
+                self.priority
+            }
+        }
+
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Priority Test".to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig::default(),
+            behavior: HashMap::new(),
+            tts: None,
+            moderation: crate::config::ModerationConfig::default(),
+        };
+
+        let agent = Agent::new(config);
+        // Added lowest-priority first; insertion keeps the list sorted, so
+        // dispatch must still pick the highest-priority response
+        agent
+            .add_behavior(FixedResponseBehavior { response: "low", priority: 5 })
+            .await;
+        agent
+            .add_behavior(FixedResponseBehavior { response: "high", priority: 90 })
+            .await;
+        agent
+            .add_behavior(FixedResponseBehavior { response: "mid", priority: 50 })
+            .await;
+
+        let response = agent.process_input("anything at all").await.unwrap();
+        assert_eq!(response, "high");
+    }
+
+    #[tokio::test]
+    async fn test_conversation_history_respects_episodic_budget() {
+        use crate::oxyde_game::behavior::{Behavior, BehaviorResult};
+        use crate::oxyde_game::intent::Intent;
+
+        #[derive(Debug)]
+        struct AlwaysRespondBehavior;
+
+        #[async_trait::async_trait]
+        impl Behavior for AlwaysRespondBehavior {
+            async fn matches_intent(&self, _intent: &Intent) -> bool {
+                true
+            }
+
+            async fn execute(
+                &self,
+                _intent: &Intent,
+                _context: &AgentContext,
+            ) -> crate::Result<BehaviorResult> {
+                Ok(BehaviorResult::Response("noted".to_string()))
+            }
+
+            fn priority(&self) -> u32 {
+                10
+            }
+        }
+
+        let mut category_budgets = HashMap::new();
+        category_budgets.insert("episodic".to_string(), 6);
+
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Budget Test".to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig {
+                short_term_capacity: 4,
+                category_budgets,
+                ..Default::default()
+            },
+            inference: InferenceConfig::default(),
+            behavior: HashMap::new(),
+            tts: None,
+            moderation: crate::config::ModerationConfig::default(),
+        };
+
+        let agent = Agent::new(config);
+        agent.add_behavior(AlwaysRespondBehavior).await;
+        agent.start().await.unwrap();
+
+        // Each turn stores the player input as an episodic memory; far more
+        // turns than the budget must not grow history without bound
+        for turn in 0..12 {
+            agent
+                .process_input(&format!("turn number {}", turn))
+                .await
+                .unwrap();
+        }
+
+        let episodic = agent.memory.get_by_category(MemoryCategory::Episodic).await;
+        assert!(
+            episodic.len() <= 6,
+            "episodic history should stay within its budget, got {}",
+            episodic.len()
+        );
+        // Conversation turns must stay evictable — none may be permanent
+        assert!(episodic.iter().all(|m| !m.permanent));
+    }
 }
\ No newline at end of file
@@ -1,43 +1,79 @@
+use std::collections::hash_map::DefaultHasher;
 use std::collections::HashMap;
+use std::hash::{Hash, Hasher};
+use std::sync::{Arc, Mutex};
 use std::time::{Duration, SystemTime};
-use serde::{Deserialize, Serialize};
+
+/// Number of independent shards the cache is split across. Keys are
+/// distributed by hash so concurrent synthesis for different NPCs rarely
+/// contends on the same lock.
+const AUDIO_CACHE_SHARDS: usize = 8;
 
 /// Caches audio data with LRU eviction and statistics.
-#[derive(Debug, Clone, Serialize, Deserialize)]
+///
+/// The cache is internally sharded and safe to use from multiple tasks
+/// through a shared reference — all methods take `&self`. Hits hand out an
+/// `Arc<AudioData>` so no audio bytes are copied on the hot path.
+#[derive(Debug)]
 pub struct AudioCache {
-    cache: HashMap<String, CachedAudio>,
+    shards: Vec<Mutex<CacheShard>>,
     max_size_bytes: usize,
+    shard_max_bytes: usize,
+}
+
+#[derive(Debug, Default)]
+struct CacheShard {
+    entries: HashMap<String, CachedAudio>,
     current_size_bytes: usize,
 }
 
-#[derive(Debug, Clone, Serialize, Deserialize)]
+#[derive(Debug)]
 struct CachedAudio {
-    data: super::AudioData,
+    data: Arc<super::AudioData>,
     created_at: SystemTime,
     access_count: u32,
     last_accessed: SystemTime,
 }
 
-
 impl AudioCache {
     /// Create a new audio cache with a specified maximum size in megabytes.
     /// The cache will evict the least recently used entries when it exceeds this size.
     pub fn new(max_size_mb: usize) -> Self {
+        let max_size_bytes = max_size_mb * 1024 * 1024;
         Self {
-            cache: HashMap::new(),
-            max_size_bytes: max_size_mb * 1024 * 1024,
-            current_size_bytes: 0,
+            shards: (0..AUDIO_CACHE_SHARDS)
+                .map(|_| Mutex::new(CacheShard::default()))
+                .collect(),
+            max_size_bytes,
+            // Capacity is enforced per shard; a pathological key distribution
+            // can under-fill some shards but the total never exceeds the cap.
+            shard_max_bytes: max_size_bytes / AUDIO_CACHE_SHARDS,
         }
     }
 
+    fn shard_for(&self, key: &str) -> &Mutex<CacheShard> {
+        let mut hasher = DefaultHasher::new();
+        key.hash(&mut hasher);
+        &self.shards[(hasher.finish() as usize) % AUDIO_CACHE_SHARDS]
+    }
+
+    fn lock_shard(shard: &Mutex<CacheShard>) -> std::sync::MutexGuard<'_, CacheShard> {
+        shard.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Audio cache shard lock poisoned, recovering");
+            poisoned.into_inner()
+        })
+    }
+
     /// Get the audio data from the cache by key.
-    /// If the key exists, it updates the access statistics and returns the audio data.
-    pub fn get(&mut self, key: &str) -> Option<super::AudioData> {
-        if let Some(cached) = self.cache.get_mut(key) {
+    /// If the key exists, it updates the access statistics and returns a
+    /// shared handle to the audio data (no bytes are copied).
+    pub fn get(&self, key: &str) -> Option<Arc<super::AudioData>> {
+        let mut shard = Self::lock_shard(self.shard_for(key));
+        if let Some(cached) = shard.entries.get_mut(key) {
             // Update access statistics
             cached.access_count += 1;
             cached.last_accessed = SystemTime::now();
-            Some(cached.data.clone())
+            Some(Arc::clone(&cached.data))
         } else {
             None
         }
@@ -45,16 +81,17 @@ impl AudioCache {
 
     /// Insert new audio data into the cache.
     /// If the key already exists, it replaces the existing entry.
-    pub fn insert(&mut self, key: String, data: super::AudioData) {
+    pub fn insert(&self, key: String, data: Arc<super::AudioData>) {
         let data_size = data.size_bytes();
+        let mut shard = Self::lock_shard(self.shard_for(&key));
 
         // Remove existing entry if present
-        if let Some(existing) = self.cache.remove(&key) {
-            self.current_size_bytes -= existing.data.size_bytes();
+        if let Some(existing) = shard.entries.remove(&key) {
+            shard.current_size_bytes -= existing.data.size_bytes();
         }
 
         // Ensure we have space for the new entry
-        self.ensure_capacity(data_size);
+        shard.ensure_capacity(data_size, self.shard_max_bytes);
 
         let cached_audio = CachedAudio {
             data,
@@ -63,50 +100,57 @@ impl AudioCache {
             last_accessed: SystemTime::now(),
         };
 
-        self.cache.insert(key, cached_audio);
-        self.current_size_bytes += data_size;
+        shard.entries.insert(key, cached_audio);
+        shard.current_size_bytes += data_size;
     }
 
     /// Remove an entry from the cache by key.
     /// If the key exists, it removes the entry and returns the audio data.
-    pub fn remove(&mut self, key: &str) -> Option<super::AudioData> {
-        if let Some(cached) = self.cache.remove(key) {
-            self.current_size_bytes -= cached.data.size_bytes();
-            Some(cached.data)
-        } else {
-            None
-        }
+    pub fn remove(&self, key: &str) -> Option<Arc<super::AudioData>> {
+        let mut shard = Self::lock_shard(self.shard_for(key));
+        shard.remove(key)
     }
 
     /// Check if the cache contains a key.
     /// Returns true if the key exists in the cache, false otherwise.
     pub fn contains_key(&self, key: &str) -> bool {
-        self.cache.contains_key(key)
+        Self::lock_shard(self.shard_for(key)).entries.contains_key(key)
     }
 
     /// Clear the cache, removing all entries.
     /// This resets the cache size to zero.
-    pub fn clear(&mut self) {
-        self.cache.clear();
-        self.current_size_bytes = 0;
+    pub fn clear(&self) {
+        for shard in &self.shards {
+            let mut shard = Self::lock_shard(shard);
+            shard.entries.clear();
+            shard.current_size_bytes = 0;
+        }
     }
 
     /// Get the number of entries in the cache.
     /// Returns the count of cached audio entries.
     pub fn len(&self) -> usize {
-        self.cache.len()
+        self.shards
+            .iter()
+            .map(|s| Self::lock_shard(s).entries.len())
+            .sum()
     }
 
     /// Check if the cache is empty.
     /// Returns true if there are no entries in the cache, false otherwise.
     pub fn is_empty(&self) -> bool {
-        self.cache.is_empty()
+        self.shards
+            .iter()
+            .all(|s| Self::lock_shard(s).entries.is_empty())
     }
 
     /// Get the current size of the cache in bytes.
     /// Returns the total size of all cached audio data.
     pub fn current_size_bytes(&self) -> usize {
-        self.current_size_bytes
+        self.shards
+            .iter()
+            .map(|s| Self::lock_shard(s).current_size_bytes)
+            .sum()
     }
 
     /// Get the maximum size of the cache in bytes.
@@ -121,82 +165,69 @@ impl AudioCache {
         if self.max_size_bytes == 0 {
             0.0
         } else {
-            (self.current_size_bytes as f64 / self.max_size_bytes as f64) * 100.0
+            (self.current_size_bytes() as f64 / self.max_size_bytes as f64) * 100.0
         }
     }
 
     /// Cleanup expired entries based on the specified maximum age.
     /// This method removes entries that have not been accessed within the specified duration.
-    pub fn cleanup_expired(&mut self, max_age: Duration) {
+    pub fn cleanup_expired(&self, max_age: Duration) {
         let now = SystemTime::now();
-        let mut keys_to_remove = Vec::new();
-
-        for (key, cached) in &self.cache {
-            if let Ok(age) = now.duration_since(cached.created_at) {
-                if age > max_age {
-                    keys_to_remove.push(key.clone());
-                }
-            }
-        }
-
-        for key in keys_to_remove {
-            self.remove(&key);
-        }
-    }
-
-    fn ensure_capacity(&mut self, needed_bytes: usize) {
-        while self.current_size_bytes + needed_bytes > self.max_size_bytes && !self.cache.is_empty()
-        {
-            self.evict_lru();
-        }
-    }
+        for shard in &self.shards {
+            let mut shard = Self::lock_shard(shard);
+            let keys_to_remove: Vec<String> = shard
+                .entries
+                .iter()
+                .filter(|(_, cached)| {
+                    now.duration_since(cached.created_at)
+                        .map(|age| age > max_age)
+                        .unwrap_or(false)
+                })
+                .map(|(key, _)| key.clone())
+                .collect();
 
-    //evicts least recently used entry
-    fn evict_lru(&mut self) {
-        let mut oldest_key: Option<String> = None;
-        let mut oldest_time = SystemTime::now();
-
-        for (key, cached) in &self.cache {
-            if cached.last_accessed < oldest_time {
-                oldest_time = cached.last_accessed;
-                oldest_key = Some(key.clone());
+            for key in keys_to_remove {
+                shard.remove(&key);
             }
         }
-
-        if let Some(key) = oldest_key {
-            self.remove(&key);
-        }
     }
 
     /// Get statistics about the cache, including entry count, current size, max size, and usage percentage.
     /// Returns a `CacheStats` struct containing the statistics.
     pub fn stats(&self) -> CacheStats {
+        let mut entry_count = 0;
+        let mut current_size_bytes = 0;
         let mut total_access_count = 0;
         let mut oldest_entry = SystemTime::now();
         let mut newest_entry = SystemTime::UNIX_EPOCH;
 
-        for cached in self.cache.values() {
-            total_access_count += cached.access_count;
-            if cached.created_at < oldest_entry {
-                oldest_entry = cached.created_at;
-            }
-            if cached.created_at > newest_entry {
-                newest_entry = cached.created_at;
+        for shard in &self.shards {
+            let shard = Self::lock_shard(shard);
+            entry_count += shard.entries.len();
+            current_size_bytes += shard.current_size_bytes;
+            for cached in shard.entries.values() {
+                total_access_count += cached.access_count;
+                if cached.created_at < oldest_entry {
+                    oldest_entry = cached.created_at;
+                }
+                if cached.created_at > newest_entry {
+                    newest_entry = cached.created_at;
+                }
             }
         }
 
         CacheStats {
-            entry_count: self.cache.len(),
-            current_size_bytes: self.current_size_bytes,
+            entry_count,
+            current_size_bytes,
             max_size_bytes: self.max_size_bytes,
             usage_percentage: self.usage_percentage(),
             total_access_count,
-            oldest_entry: if self.cache.is_empty() {
+            oldest_entry: if entry_count == 0 {
                 None
             } else {
                 Some(oldest_entry)
             },
-            newest_entry: if self.cache.is_empty() {
+            newest_entry: if entry_count == 0 {
                 None
             } else {
                 Some(newest_entry)
@@ -205,6 +236,40 @@ impl AudioCache {
     }
 }
 
+impl CacheShard {
+    fn remove(&mut self, key: &str) -> Option<Arc<super::AudioData>> {
+        if let Some(cached) = self.entries.remove(key) {
+            self.current_size_bytes -= cached.data.size_bytes();
+            Some(cached.data)
+        } else {
+            None
+        }
+    }
+
+    fn ensure_capacity(&mut self, needed_bytes: usize, max_bytes: usize) {
+        while self.current_size_bytes + needed_bytes > max_bytes && !self.entries.is_empty() {
+            self.evict_lru();
+        }
+    }
+
+    //evicts least recently used entry
+    fn evict_lru(&mut self) {
+        let mut oldest_key: Option<String> = None;
+        let mut oldest_time = SystemTime::now();
+
+        for (key, cached) in &self.entries {
+            if cached.last_accessed < oldest_time {
+                oldest_time = cached.last_accessed;
+                oldest_key = Some(key.clone());
+            }
+        }
+
+        if let Some(key) = oldest_key {
+            self.remove(&key);
+        }
+    }
+}
+
 /// Statistics about the audio cache.
 /// This struct contains information about the number of entries, current size, maximum size, usage percentage
 /// Statistics about the audio cache.
@@ -238,3 +303,63 @@ impl std::fmt::Display for CacheStats {
         )
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::audio::{AudioData, AudioFormat};
+
+    fn sample_audio(size: usize) -> Arc<AudioData> {
+        Arc::new(AudioData {
+            format: AudioFormat::MP3,
+            data: vec![0u8; size],
+            sample_rate: 22050,
+            channels: 1,
+            duration_ms: 100,
+        })
+    }
+
+    #[test]
+    fn test_hit_returns_shared_handle() {
+        let cache = AudioCache::new(1);
+        let audio = sample_audio(512);
+        cache.insert("greeting".to_string(), Arc::clone(&audio));
+
+        let hit = cache.get("greeting").expect("entry should be cached");
+        assert!(Arc::ptr_eq(&hit, &audio));
+        assert!(cache.get("missing").is_none());
+    }
+
+    #[test]
+    fn test_eviction_respects_size_cap() {
+        let cache = AudioCache::new(1);
+        // Each shard holds at most 128 KiB of a 1 MiB cache; three 100 KiB
+        // entries hashed anywhere will force at least one eviction once a
+        // shard fills up, and the total must stay under the configured cap.
+        for i in 0..32 {
+            cache.insert(format!("line_{}", i), sample_audio(100 * 1024));
+        }
+        assert!(cache.current_size_bytes() <= cache.max_size_bytes());
+        assert!(cache.len() < 32);
+    }
+
+    #[test]
+    fn test_concurrent_access_from_shared_reference() {
+        let cache = Arc::new(AudioCache::new(4));
+        let mut handles = Vec::new();
+        for t in 0..4 {
+            let cache = Arc::clone(&cache);
+            handles.push(std::thread::spawn(move || {
+                for i in 0..50 {
+                    let key = format!("npc_{}_{}", t, i);
+                    cache.insert(key.clone(), sample_audio(256));
+                    assert!(cache.get(&key).is_some());
+                }
+            }));
+        }
+        for handle in handles {
+            handle.join().unwrap();
+        }
+        assert_eq!(cache.stats().entry_count, cache.len());
+    }
+}
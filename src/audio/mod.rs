@@ -10,12 +10,15 @@ pub mod audio_cache;
 pub mod emotion;
 /// TTS providers module.
 pub mod providers;
+/// Sentence-level TTS pipelining module.
+pub mod speech_pipeline;
 /// Voice profiles module.
 pub mod voice_profiles;
 
 pub use audio_cache::*;
 // pub use emotion::EmotionalState;
 pub use providers::*;
+pub use speech_pipeline::SpeechPipeline;
 pub use voice_profiles::*;
 
 /// Represents audio data generated by TTS synthesis.
@@ -45,8 +48,9 @@ impl AudioData {
 pub struct TTSService {
     /// The TTS provider being used (ElevenLabs).
     provider: TTSProvider,
-    /// Shared audio cache for storing synthesized audio.
-    pub cache: Arc<RwLock<AudioCache>>,
+    /// Shared audio cache for storing synthesized audio. The cache is
+    /// internally sharded, so no outer lock is needed.
+    pub cache: Arc<AudioCache>,
     /// Shared voice profiles for NPCs.
     voice_profiles: Arc<RwLock<HashMap<String, VoiceProfile>>>,
     /// Configuration for the TTS service.
@@ -107,7 +111,7 @@ impl TTSService {
     pub fn new(provider: TTSProvider, config: TTSConfig) -> Self {
         Self {
             provider,
-            cache: Arc::new(RwLock::new(AudioCache::new(config.cache_max_size_mb))),
+            cache: Arc::new(AudioCache::new(config.cache_max_size_mb)),
             voice_profiles: Arc::new(RwLock::new(HashMap::new())),
             config,
         }
@@ -120,14 +124,15 @@ impl TTSService {
         text: &str,
         emotional_state: &EmotionalState, // Use the main SDK's EmotionalState
         urgency: f32,
-    ) -> Result<AudioData, TTSError> {
-        // Check cache first
+    ) -> Result<Arc<AudioData>, TTSError> {
+        // Check cache first; hits are pointer copies of the cached buffer
         let cache_key = self.generate_cache_key(npc_name, text, emotional_state);
         if self.config.cache_enabled {
-            let mut cache = self.cache.write().await;
-            if let Some(cached_audio) = cache.get(&cache_key) {
+            if let Some(cached_audio) = self.cache.get(&cache_key) {
+                crate::metrics::global().tts_cache_hits.increment();
                 return Ok(cached_audio);
             }
+            crate::metrics::global().tts_cache_misses.increment();
         }
 
         // Get voice profile for this NPC
@@ -145,17 +150,20 @@ impl TTSService {
         };
 
         // Generate speech with ElevenLabs
+        let synthesis_started = std::time::Instant::now();
         let audio_data = match self.provider {
-            TTSProvider::ElevenLabs => {
+            TTSProvider::ElevenLabs => Arc::new(
                 self.elevenlabs_synthesize(&enhanced_text, &voice_settings)
-                    .await?
-            }
+                    .await?,
+            ),
         };
+        crate::metrics::global()
+            .tts_synthesis
+            .record(synthesis_started.elapsed());
 
         // Cache the result
         if self.config.cache_enabled {
-            let mut cache = self.cache.write().await;
-            cache.insert(cache_key, audio_data.clone());
+            self.cache.insert(cache_key, Arc::clone(&audio_data));
         }
 
         Ok(audio_data)
@@ -275,7 +283,7 @@ impl TTSService {
         text: &str,
         settings: &VoiceSettings,
     ) -> Result<AudioData, TTSError> {
-        let client = reqwest::Client::new();
+        let client = crate::utils::http_client();
         let api_key = std::env::var("ELEVENLABS_API_KEY")
             .map_err(|_| TTSError::MissingApiKey("ElevenLabs"))?;
 
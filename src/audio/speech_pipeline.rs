@@ -0,0 +1,181 @@
+//! Sentence-level TTS pipelining for streamed inference output.
+//!
+//! Waiting for a full inference response before starting synthesis makes
+//! player-perceived voice latency the sum of both stages. The pipeline here
+//! consumes text chunks as they stream in, cuts them at sentence boundaries,
+//! and kicks off synthesis for each completed sentence while later sentences
+//! are still being generated, overlapping the two stages.
+
+use std::sync::{Arc, Mutex};
+
+use tokio::task::JoinHandle;
+
+use super::{AudioData, TTSError, TTSService};
+use crate::oxyde_game::emotion::EmotionalState;
+
+/// Pipelines sentence-level TTS synthesis over a streamed text response.
+///
+/// Feed text chunks in with [`push`](Self::push) as they arrive from the
+/// inference stream; each completed sentence is synthesized on a background
+/// task immediately. Call [`finish`](Self::finish) once the stream ends to
+/// flush the trailing partial sentence and collect the audio clips in
+/// sentence order.
+///
+/// `push` must be called from within a Tokio runtime, since it spawns the
+/// synthesis tasks.
+pub struct SpeechPipeline {
+    tts: Arc<TTSService>,
+    npc_name: String,
+    emotions: EmotionalState,
+    urgency: f32,
+    state: Mutex<PipelineState>,
+}
+
+#[derive(Default)]
+struct PipelineState {
+    buffer: String,
+    pending: Vec<JoinHandle<Result<Arc<AudioData>, TTSError>>>,
+}
+
+impl SpeechPipeline {
+    /// Create a new pipeline for one spoken response.
+    ///
+    /// # Arguments
+    ///
+    /// * `tts` - TTS service used for synthesis (shared cache included)
+    /// * `npc_name` - Name of the speaking NPC, used for voice selection
+    /// * `emotions` - Emotional state snapshot applied to every sentence
+    /// * `urgency` - Urgency level applied to every sentence
+    pub fn new(
+        tts: Arc<TTSService>,
+        npc_name: String,
+        emotions: EmotionalState,
+        urgency: f32,
+    ) -> Self {
+        Self {
+            tts,
+            npc_name,
+            emotions,
+            urgency,
+            state: Mutex::new(PipelineState::default()),
+        }
+    }
+
+    /// Feed a streamed text chunk into the pipeline.
+    ///
+    /// Any sentences completed by this chunk start synthesizing right away.
+    pub fn push(&self, chunk: &str) {
+        let mut state = self.lock_state();
+        state.buffer.push_str(chunk);
+        let sentences = drain_complete_sentences(&mut state.buffer);
+        for sentence in sentences {
+            let task = self.spawn_synthesis(sentence);
+            state.pending.push(task);
+        }
+    }
+
+    /// Flush the trailing partial sentence and wait for all synthesis tasks.
+    ///
+    /// # Returns
+    ///
+    /// Audio clips in sentence order, or the first synthesis error.
+    pub async fn finish(self) -> Result<Vec<Arc<AudioData>>, TTSError> {
+        let pending = {
+            let mut state = self.lock_state();
+            let tail = state.buffer.trim().to_string();
+            state.buffer.clear();
+            if !tail.is_empty() {
+                let task = self.spawn_synthesis(tail);
+                state.pending.push(task);
+            }
+            std::mem::take(&mut state.pending)
+        };
+
+        let mut clips = Vec::with_capacity(pending.len());
+        for task in pending {
+            let clip = task.await.map_err(|e| {
+                TTSError::AudioProcessingError(format!("Synthesis task failed: {}", e))
+            })??;
+            clips.push(clip);
+        }
+        Ok(clips)
+    }
+
+    fn spawn_synthesis(&self, sentence: String) -> JoinHandle<Result<Arc<AudioData>, TTSError>> {
+        let tts = Arc::clone(&self.tts);
+        let npc_name = self.npc_name.clone();
+        let emotions = self.emotions.clone();
+        let urgency = self.urgency;
+        tokio::spawn(async move {
+            tts.synthesize_npc_speech(&npc_name, &sentence, &emotions, urgency)
+                .await
+        })
+    }
+
+    fn lock_state(&self) -> std::sync::MutexGuard<'_, PipelineState> {
+        self.state.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Speech pipeline lock poisoned, recovering");
+            poisoned.into_inner()
+        })
+    }
+}
+
+/// Split all completed sentences off the front of `buffer`.
+///
+/// A sentence is considered complete once a terminator (`.`, `!`, `?`) is
+/// followed by whitespace; this keeps decimals like "3.5" intact and leaves
+/// the trailing text in `buffer` until the stream ends, since a terminator at
+/// the current end of the buffer may still be mid-token.
+fn drain_complete_sentences(buffer: &mut String) -> Vec<String> {
+    let mut sentences = Vec::new();
+    'scan: loop {
+        let mut prev_terminator = false;
+        for (idx, ch) in buffer.char_indices() {
+            if prev_terminator && ch.is_whitespace() {
+                let sentence = buffer[..idx].trim().to_string();
+                let rest = buffer[idx..].trim_start().to_string();
+                *buffer = rest;
+                if !sentence.is_empty() {
+                    sentences.push(sentence);
+                }
+                continue 'scan;
+            }
+            prev_terminator = matches!(ch, '.' | '!' | '?');
+        }
+        break;
+    }
+    sentences
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_sentences_split_at_boundaries() {
+        let mut buffer = String::from("Hello there! How are you today? I have wares.");
+        let sentences = drain_complete_sentences(&mut buffer);
+        assert_eq!(sentences, vec!["Hello there!", "How are you today?"]);
+        // The last sentence stays buffered until more text (or the end of
+        // the stream) confirms it is complete.
+        assert_eq!(buffer, "I have wares.");
+    }
+
+    #[test]
+    fn test_partial_chunks_accumulate() {
+        let mut buffer = String::from("The price is 3.5 gold");
+        assert!(drain_complete_sentences(&mut buffer).is_empty());
+        buffer.push_str(" pieces. Take it or leave it");
+        let sentences = drain_complete_sentences(&mut buffer);
+        assert_eq!(sentences, vec!["The price is 3.5 gold pieces."]);
+        assert_eq!(buffer, "Take it or leave it");
+    }
+
+    #[test]
+    fn test_consecutive_terminators_stay_together() {
+        let mut buffer = String::from("What?! You again. ");
+        let sentences = drain_complete_sentences(&mut buffer);
+        assert_eq!(sentences, vec!["What?!", "You again."]);
+        assert!(buffer.is_empty());
+    }
+}
@@ -3,15 +3,32 @@
 //! This module provides configuration structures for agents, inference engines,
 //! memory systems, and behaviors.
 
+use std::collections::hash_map::DefaultHasher;
 use std::collections::HashMap;
 use std::fs::File;
-use std::io::BufReader;
+use std::hash::{Hash, Hasher};
+use std::io::{BufReader, BufWriter, ErrorKind, Read, Write};
 use std::path::Path;
+use std::sync::{Arc, Mutex};
 
+use lazy_static::lazy_static;
 use serde::{Deserialize, Serialize};
 
+use crate::memory::{read_bytes, read_string, write_bytes};
 use crate::{audio::TTSConfig, OxydeError, Result};
 
+/// Bound on the parsed config cache; cleared wholesale when full so a tool
+/// iterating over many one-off configs cannot grow it without limit.
+const CONFIG_CACHE_CAPACITY: usize = 256;
+
+lazy_static! {
+    /// Parsed and validated configurations keyed by file content hash.
+    /// Spawning the same NPC archetype many times resolves to one parse;
+    /// editing the file changes the hash and naturally misses the cache.
+    static ref CONFIG_CACHE: Mutex<HashMap<u64, Arc<AgentConfig>>> =
+        Mutex::new(HashMap::new());
+}
+
 /// Configuration for an agent's personality and behavior
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct AgentPersonality {
@@ -45,6 +62,27 @@ impl Default for EmbeddingModelType {
     }
 }
 
+impl EmbeddingModelType {
+    /// Stable tag used by the compiled binary config format
+    fn as_u8(&self) -> u8 {
+        match self {
+            Self::MiniBert => 0,
+            Self::DistilBert => 1,
+            Self::Custom => 2,
+        }
+    }
+
+    /// Inverse of [`as_u8`](Self::as_u8)
+    fn from_u8(value: u8) -> Option<Self> {
+        match value {
+            0 => Some(Self::MiniBert),
+            1 => Some(Self::DistilBert),
+            2 => Some(Self::Custom),
+            _ => None,
+        }
+    }
+}
+
 /// Configuration for the memory system
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct MemoryConfig {
@@ -86,6 +124,25 @@ pub struct MemoryConfig {
     /// Memory categories to prioritize
     #[serde(default)]
     pub priority_categories: Vec<String>,
+
+    /// Hard per-category memory budgets, keyed by category name
+    /// ("episodic", "semantic", "procedural", "emotional")
+    ///
+    /// A category at its budget evicts its least valuable entry on insert
+    /// instead of growing; categories without a budget share the global
+    /// capacity.
+    #[serde(default)]
+    pub category_budgets: HashMap<String, usize>,
+
+    /// Age in seconds after which low-importance episodic memories become
+    /// candidates for background consolidation
+    #[serde(default = "default_consolidation_age")]
+    pub consolidation_age_secs: u64,
+
+    /// Importance below which aged episodic memories are consolidated
+    /// rather than kept verbatim (0.0 - 1.0)
+    #[serde(default = "default_consolidation_threshold")]
+    pub consolidation_importance_threshold: f64,
 }
 
 fn default_memory_capacity() -> usize {
@@ -108,6 +165,14 @@ fn default_embedding_dim() -> usize {
     384 // Standard dimension for mini BERT models
 }
 
+fn default_consolidation_age() -> u64 {
+    3600 // One in-game hour of aging before merging
+}
+
+fn default_consolidation_threshold() -> f64 {
+    0.3
+}
+
 impl Default for MemoryConfig {
     fn default() -> Self {
         Self {
@@ -121,6 +186,9 @@ impl Default for MemoryConfig {
             custom_model_path: None,
             embedding_dimension: default_embedding_dim(),
             priority_categories: Vec::new(),
+            category_budgets: HashMap::new(),
+            consolidation_age_secs: default_consolidation_age(),
+            consolidation_importance_threshold: default_consolidation_threshold(),
         }
     }
 }
@@ -182,6 +250,38 @@ impl MemoryConfig {
             ));
         }
 
+        // Validate per-category budgets
+        for (category, budget) in &self.category_budgets {
+            if crate::memory::MemoryCategory::from_str(category).is_none() {
+                return Err(OxydeError::ConfigurationError(
+                    format!("Unknown memory category in budgets: '{}'", category)
+                ));
+            }
+            if *budget == 0 {
+                return Err(OxydeError::ConfigurationError(
+                    format!("Budget for memory category '{}' must be greater than 0", category)
+                ));
+            }
+            if *budget > self.capacity {
+                return Err(OxydeError::ConfigurationError(
+                    format!(
+                        "Budget for memory category '{}' ({}) cannot exceed total capacity ({})",
+                        category, budget, self.capacity
+                    )
+                ));
+            }
+        }
+
+        // Validate consolidation threshold (0.0 - 1.0)
+        if !(0.0..=1.0).contains(&self.consolidation_importance_threshold) {
+            return Err(OxydeError::ConfigurationError(
+                format!(
+                    "Consolidation importance threshold must be between 0.0 and 1.0, got {}",
+                    self.consolidation_importance_threshold
+                )
+            ));
+        }
+
         // Validate custom model path if using custom embedding model
         if self.embedding_model == EmbeddingModelType::Custom {
             if self.custom_model_path.is_none() {
@@ -201,6 +301,19 @@ impl MemoryConfig {
 
         Ok(())
     }
+
+    /// Look up the hard budget for a memory category, if one is configured
+    ///
+    /// # Arguments
+    ///
+    /// * `category` - Memory category to look up
+    ///
+    /// # Returns
+    ///
+    /// The configured budget, or None if the category is unbudgeted
+    pub fn budget_for(&self, category: crate::memory::MemoryCategory) -> Option<usize> {
+        self.category_budgets.get(category.as_str()).copied()
+    }
 }
 
 /// Configuration for the inference engine
@@ -237,6 +350,52 @@ pub struct InferenceConfig {
 
     /// Fallback API to use if primary fails
     pub fallback_api: Option<String>,
+
+    /// Batching window for inference requests in milliseconds
+    ///
+    /// Requests arriving within the window are coalesced and dispatched
+    /// together. A value of 0 disables batching.
+    #[serde(default = "default_batch_window")]
+    pub batch_window_ms: u64,
+
+    /// Maximum number of requests dispatched in one batch
+    #[serde(default = "default_max_batch_size")]
+    pub max_batch_size: usize,
+
+    /// Total capacity of the response cache, in entries
+    ///
+    /// Responses are cached keyed on the input, persona prompt, memory set
+    /// and context, so repeated lines like "hi" are answered without a
+    /// provider call. A value of 0 disables the cache.
+    #[serde(default = "default_response_cache_size")]
+    pub response_cache_size: usize,
+
+    /// Time-to-live for cached responses in milliseconds
+    #[serde(default = "default_response_cache_ttl")]
+    pub response_cache_ttl_ms: u64,
+
+    /// Route short inputs to the local model even when cloud inference is
+    /// configured
+    ///
+    /// Trivial barks and greetings don't need a network round trip; with
+    /// hybrid routing enabled they run on the local model and only inputs
+    /// longer than `local_max_input_chars` escalate to the cloud provider.
+    /// Requires `local_model_path` to be set.
+    #[serde(default)]
+    pub hybrid_routing: bool,
+
+    /// Inputs at or below this many characters qualify for local routing
+    #[serde(default = "default_local_max_input_chars")]
+    pub local_max_input_chars: usize,
+
+    /// Token budget for the assembled prompt
+    ///
+    /// Retrieved memories are trimmed so the estimated prompt size (using
+    /// the ~4 characters per token heuristic) stays within the budget,
+    /// keeping oversized prompts off the wire. A value of 0 disables
+    /// trimming.
+    #[serde(default = "default_prompt_token_budget")]
+    pub prompt_token_budget: usize,
 }
 
 fn default_model() -> String {
@@ -255,6 +414,30 @@ fn default_timeout() -> u64 {
     5000
 }
 
+fn default_batch_window() -> u64 {
+    0
+}
+
+fn default_max_batch_size() -> usize {
+    8
+}
+
+fn default_response_cache_size() -> usize {
+    256
+}
+
+fn default_response_cache_ttl() -> u64 {
+    60_000
+}
+
+fn default_local_max_input_chars() -> usize {
+    120
+}
+
+fn default_prompt_token_budget() -> usize {
+    2048
+}
+
 impl Default for InferenceConfig {
     fn default() -> Self {
         Self {
@@ -267,6 +450,13 @@ impl Default for InferenceConfig {
             max_tokens: default_max_tokens(),
             timeout_ms: default_timeout(),
             fallback_api: None,
+            batch_window_ms: default_batch_window(),
+            max_batch_size: default_max_batch_size(),
+            response_cache_size: default_response_cache_size(),
+            response_cache_ttl_ms: default_response_cache_ttl(),
+            hybrid_routing: false,
+            local_max_input_chars: default_local_max_input_chars(),
+            prompt_token_budget: default_prompt_token_budget(),
         }
     }
 }
@@ -337,6 +527,21 @@ impl InferenceConfig {
             }
         }
 
+        // Validate hybrid routing configuration
+        if self.hybrid_routing {
+            if self.local_model_path.is_none() {
+                return Err(OxydeError::ConfigurationError(
+                    "Local model path must be provided when hybrid_routing is true".to_string()
+                ));
+            }
+
+            if self.local_max_input_chars == 0 {
+                return Err(OxydeError::ConfigurationError(
+                    "local_max_input_chars must be greater than 0 when hybrid_routing is true".to_string()
+                ));
+            }
+        }
+
         // Validate cloud API configuration
         if !self.use_local {
             if self.api_endpoint.is_none() {
@@ -428,6 +633,81 @@ impl Default for ModerationConfig {
     }
 }
 
+/// Magic bytes identifying a compiled Oxyde agent config file
+const COMPILED_MAGIC: &[u8; 4] = b"OXAC";
+
+/// Current version of the compiled binary config format
+const COMPILED_VERSION: u32 = 1;
+
+/// Write a length-prefixed list of strings to a binary record stream
+fn write_string_vec<W: Write>(writer: &mut W, values: &[String]) -> std::io::Result<()> {
+    writer.write_all(&(values.len() as u32).to_le_bytes())?;
+    for value in values {
+        write_bytes(writer, value.as_bytes())?;
+    }
+    Ok(())
+}
+
+/// Read a length-prefixed list of strings from a binary record stream
+fn read_string_vec<R: Read>(reader: &mut R) -> std::io::Result<Vec<String>> {
+    let count = read_u32(reader)? as usize;
+    let mut values = Vec::with_capacity(count);
+    for _ in 0..count {
+        values.push(read_string(reader)?);
+    }
+    Ok(values)
+}
+
+/// Write an optional string as a presence byte plus payload
+fn write_opt_string<W: Write>(writer: &mut W, value: &Option<String>) -> std::io::Result<()> {
+    match value {
+        Some(value) => {
+            writer.write_all(&[1])?;
+            write_bytes(writer, value.as_bytes())
+        }
+        None => writer.write_all(&[0]),
+    }
+}
+
+/// Read an optional string written by [`write_opt_string`]
+fn read_opt_string<R: Read>(reader: &mut R) -> std::io::Result<Option<String>> {
+    if read_u8(reader)? != 0 {
+        Ok(Some(read_string(reader)?))
+    } else {
+        Ok(None)
+    }
+}
+
+fn read_u8<R: Read>(reader: &mut R) -> std::io::Result<u8> {
+    let mut buf = [0u8; 1];
+    reader.read_exact(&mut buf)?;
+    Ok(buf[0])
+}
+
+fn read_u32<R: Read>(reader: &mut R) -> std::io::Result<u32> {
+    let mut buf = [0u8; 4];
+    reader.read_exact(&mut buf)?;
+    Ok(u32::from_le_bytes(buf))
+}
+
+fn read_u64<R: Read>(reader: &mut R) -> std::io::Result<u64> {
+    let mut buf = [0u8; 8];
+    reader.read_exact(&mut buf)?;
+    Ok(u64::from_le_bytes(buf))
+}
+
+fn read_f32<R: Read>(reader: &mut R) -> std::io::Result<f32> {
+    let mut buf = [0u8; 4];
+    reader.read_exact(&mut buf)?;
+    Ok(f32::from_le_bytes(buf))
+}
+
+fn read_f64<R: Read>(reader: &mut R) -> std::io::Result<f64> {
+    let mut buf = [0u8; 8];
+    reader.read_exact(&mut buf)?;
+    Ok(f64::from_le_bytes(buf))
+}
+
 /// Complete agent configuration
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct AgentConfig {
@@ -527,9 +807,13 @@ impl AgentConfig {
                     OxydeError::ConfigurationError(format!("Failed to parse YAML config: {}", e))
                 })?
             },
+            Some("oxc") => {
+                let mut reader = reader;
+                Self::read_compiled(&mut reader)?
+            },
             _ => {
                 return Err(OxydeError::ConfigurationError(
-                    "Unknown config file format. Expected .json, .yaml, or .yml".to_string()
+                    "Unknown config file format. Expected .json, .yaml, .yml, or .oxc".to_string()
                 ));
             }
         };
@@ -568,6 +852,347 @@ impl AgentConfig {
             )),
         }
     }
+
+    /// Load an agent configuration through the process-wide config cache
+    ///
+    /// The file is read once and keyed by its content hash, so spawning the
+    /// same NPC archetype many times parses and validates the configuration
+    /// exactly once; subsequent loads are a hash plus a map lookup. Editing
+    /// the file changes the hash and misses the cache naturally.
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Path to the configuration file (JSON, YAML, or compiled .oxc)
+    ///
+    /// # Returns
+    ///
+    /// A shared handle to the validated AgentConfig or an error
+    pub fn load_cached<P: AsRef<Path>>(path: P) -> Result<Arc<Self>> {
+        let path = path.as_ref();
+        let bytes = std::fs::read(path).map_err(|e| {
+            OxydeError::ConfigurationError(format!("Failed to read config file: {}", e))
+        })?;
+
+        let key = Self::cache_key(&bytes);
+        if let Some(config) = Self::cache_get(key) {
+            return Ok(config);
+        }
+
+        let extension = path.extension().and_then(|ext| ext.to_str());
+        let config: AgentConfig = match extension {
+            Some("json") => serde_json::from_slice(&bytes).map_err(|e| {
+                OxydeError::ConfigurationError(format!("Failed to parse JSON config: {}", e))
+            })?,
+            Some("yaml") | Some("yml") => serde_yaml::from_slice(&bytes).map_err(|e| {
+                OxydeError::ConfigurationError(format!("Failed to parse YAML config: {}", e))
+            })?,
+            Some("oxc") => {
+                let mut reader = bytes.as_slice();
+                Self::read_compiled(&mut reader)?
+            }
+            _ => {
+                return Err(OxydeError::ConfigurationError(
+                    "Unknown config file format. Expected .json, .yaml, .yml, or .oxc".to_string()
+                ));
+            }
+        };
+        config.validate()?;
+
+        Ok(Self::cache_insert(key, config))
+    }
+
+    /// Parse an agent configuration from a JSON string through the config cache
+    ///
+    /// Same caching behavior as [`load_cached`](Self::load_cached) for
+    /// callers that already hold the config contents, such as engine
+    /// bindings receiving configs over FFI.
+    ///
+    /// # Arguments
+    ///
+    /// * `json` - JSON string containing the agent configuration
+    ///
+    /// # Returns
+    ///
+    /// A shared handle to the validated AgentConfig or an error
+    pub fn parse_cached_json(json: &str) -> Result<Arc<Self>> {
+        let key = Self::cache_key(json.as_bytes());
+        if let Some(config) = Self::cache_get(key) {
+            return Ok(config);
+        }
+
+        let config: AgentConfig = serde_json::from_str(json).map_err(|e| {
+            OxydeError::ConfigurationError(format!("Failed to parse JSON config: {}", e))
+        })?;
+        config.validate()?;
+
+        Ok(Self::cache_insert(key, config))
+    }
+
+    /// Hash config contents into a cache key
+    fn cache_key(bytes: &[u8]) -> u64 {
+        let mut hasher = DefaultHasher::new();
+        bytes.hash(&mut hasher);
+        hasher.finish()
+    }
+
+    /// Look up a parsed configuration by content hash
+    fn cache_get(key: u64) -> Option<Arc<Self>> {
+        let cache = CONFIG_CACHE.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Config cache lock poisoned, recovering");
+            poisoned.into_inner()
+        });
+        cache.get(&key).map(Arc::clone)
+    }
+
+    /// Insert a parsed configuration, clearing the cache wholesale at capacity
+    fn cache_insert(key: u64, config: Self) -> Arc<Self> {
+        let config = Arc::new(config);
+        let mut cache = CONFIG_CACHE.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Config cache lock poisoned, recovering");
+            poisoned.into_inner()
+        });
+        if cache.len() >= CONFIG_CACHE_CAPACITY {
+            cache.clear();
+        }
+        cache.insert(key, Arc::clone(&config));
+        config
+    }
+
+    /// Save the agent configuration in the compiled binary format
+    ///
+    /// Compiled configs load with a single read and no serde work, which
+    /// makes mass agent creation at level load I/O-bound instead of
+    /// parse-bound. The configuration is validated before writing so loads
+    /// never see an invalid file.
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Path to write the compiled config to (conventionally .oxc)
+    ///
+    /// # Returns
+    ///
+    /// Success or an error
+    pub fn save_compiled<P: AsRef<Path>>(&self, path: P) -> Result<()> {
+        self.validate()?;
+
+        let file = File::create(path.as_ref()).map_err(|e| {
+            OxydeError::ConfigurationError(format!("Failed to create compiled config file: {}", e))
+        })?;
+        let mut writer = BufWriter::new(file);
+
+        let result = (|| -> std::io::Result<()> {
+            writer.write_all(COMPILED_MAGIC)?;
+            writer.write_all(&COMPILED_VERSION.to_le_bytes())?;
+            self.write_binary(&mut writer)?;
+            writer.flush()
+        })();
+
+        result.map_err(|e| {
+            OxydeError::ConfigurationError(format!("Failed to write compiled config: {}", e))
+        })
+    }
+
+    /// Read a compiled config, checking the header first
+    fn read_compiled<R: Read>(reader: &mut R) -> Result<Self> {
+        let check = (|| -> std::io::Result<Self> {
+            let mut magic = [0u8; 4];
+            reader.read_exact(&mut magic)?;
+            if &magic != COMPILED_MAGIC {
+                return Err(std::io::Error::new(
+                    ErrorKind::InvalidData,
+                    "Not a compiled Oxyde config file",
+                ));
+            }
+            let version = read_u32(reader)?;
+            if version != COMPILED_VERSION {
+                return Err(std::io::Error::new(
+                    ErrorKind::InvalidData,
+                    format!("Unsupported compiled config version: {}", version),
+                ));
+            }
+            Self::read_binary(reader)
+        })();
+
+        check.map_err(|e| {
+            OxydeError::ConfigurationError(format!("Failed to read compiled config: {}", e))
+        })
+    }
+
+    /// Serialize the configuration as a compiled binary record
+    ///
+    /// Fixed fields use typed little-endian encodings; open-ended parts
+    /// (behavior parameters, TTS settings) fall back to embedded JSON since
+    /// their schemas are provider-specific and rarely hot.
+    fn write_binary<W: Write>(&self, writer: &mut W) -> std::io::Result<()> {
+        write_bytes(writer, self.agent.name.as_bytes())?;
+        write_bytes(writer, self.agent.role.as_bytes())?;
+        write_string_vec(writer, &self.agent.backstory)?;
+        write_string_vec(writer, &self.agent.knowledge)?;
+
+        writer.write_all(&(self.memory.capacity as u64).to_le_bytes())?;
+        writer.write_all(&[self.memory.persistence as u8])?;
+        writer.write_all(&self.memory.decay_rate.to_le_bytes())?;
+        writer.write_all(&self.memory.importance_threshold.to_le_bytes())?;
+        writer.write_all(&(self.memory.short_term_capacity as u64).to_le_bytes())?;
+        writer.write_all(&[self.memory.use_embeddings as u8])?;
+        writer.write_all(&[self.memory.embedding_model.as_u8()])?;
+        write_opt_string(writer, &self.memory.custom_model_path)?;
+        writer.write_all(&(self.memory.embedding_dimension as u64).to_le_bytes())?;
+        write_string_vec(writer, &self.memory.priority_categories)?;
+        writer.write_all(&(self.memory.category_budgets.len() as u32).to_le_bytes())?;
+        for (category, budget) in &self.memory.category_budgets {
+            write_bytes(writer, category.as_bytes())?;
+            writer.write_all(&(*budget as u64).to_le_bytes())?;
+        }
+        writer.write_all(&self.memory.consolidation_age_secs.to_le_bytes())?;
+        writer.write_all(&self.memory.consolidation_importance_threshold.to_le_bytes())?;
+
+        write_bytes(writer, self.inference.model.as_bytes())?;
+        writer.write_all(&[self.inference.use_local as u8])?;
+        write_opt_string(writer, &self.inference.local_model_path)?;
+        write_opt_string(writer, &self.inference.api_endpoint)?;
+        write_opt_string(writer, &self.inference.api_key)?;
+        writer.write_all(&self.inference.temperature.to_le_bytes())?;
+        writer.write_all(&(self.inference.max_tokens as u64).to_le_bytes())?;
+        writer.write_all(&self.inference.timeout_ms.to_le_bytes())?;
+        write_opt_string(writer, &self.inference.fallback_api)?;
+        writer.write_all(&self.inference.batch_window_ms.to_le_bytes())?;
+        writer.write_all(&(self.inference.max_batch_size as u64).to_le_bytes())?;
+        writer.write_all(&(self.inference.response_cache_size as u64).to_le_bytes())?;
+        writer.write_all(&self.inference.response_cache_ttl_ms.to_le_bytes())?;
+        writer.write_all(&[self.inference.hybrid_routing as u8])?;
+        writer.write_all(&(self.inference.local_max_input_chars as u64).to_le_bytes())?;
+        writer.write_all(&(self.inference.prompt_token_budget as u64).to_le_bytes())?;
+
+        writer.write_all(&[self.moderation.enabled as u8])?;
+        write_bytes(writer, self.moderation.response_message.as_bytes())?;
+        writer.write_all(&[self.moderation.use_cloud_moderation as u8])?;
+        write_opt_string(writer, &self.moderation.cloud_moderation_api_key)?;
+
+        writer.write_all(&(self.behavior.len() as u32).to_le_bytes())?;
+        for (name, behavior) in &self.behavior {
+            write_bytes(writer, name.as_bytes())?;
+            write_bytes(writer, behavior.trigger.as_bytes())?;
+            writer.write_all(&behavior.cooldown.to_le_bytes())?;
+            writer.write_all(&behavior.priority.to_le_bytes())?;
+            let parameters = serde_json::to_vec(&behavior.parameters)
+                .map_err(|e| std::io::Error::new(ErrorKind::InvalidData, e))?;
+            write_bytes(writer, &parameters)?;
+        }
+
+        match &self.tts {
+            Some(tts) => {
+                writer.write_all(&[1])?;
+                let tts_json = serde_json::to_vec(tts)
+                    .map_err(|e| std::io::Error::new(ErrorKind::InvalidData, e))?;
+                write_bytes(writer, &tts_json)?;
+            }
+            None => writer.write_all(&[0])?,
+        }
+
+        Ok(())
+    }
+
+    /// Deserialize a configuration from a compiled binary record
+    fn read_binary<R: Read>(reader: &mut R) -> std::io::Result<Self> {
+        let agent = AgentPersonality {
+            name: read_string(reader)?,
+            role: read_string(reader)?,
+            backstory: read_string_vec(reader)?,
+            knowledge: read_string_vec(reader)?,
+        };
+
+        let memory = MemoryConfig {
+            capacity: read_u64(reader)? as usize,
+            persistence: read_u8(reader)? != 0,
+            decay_rate: read_f64(reader)?,
+            importance_threshold: read_f64(reader)?,
+            short_term_capacity: read_u64(reader)? as usize,
+            use_embeddings: read_u8(reader)? != 0,
+            embedding_model: {
+                let tag = read_u8(reader)?;
+                EmbeddingModelType::from_u8(tag).ok_or_else(|| {
+                    std::io::Error::new(
+                        ErrorKind::InvalidData,
+                        format!("Invalid embedding model tag: {}", tag),
+                    )
+                })?
+            },
+            custom_model_path: read_opt_string(reader)?,
+            embedding_dimension: read_u64(reader)? as usize,
+            priority_categories: read_string_vec(reader)?,
+            category_budgets: {
+                let count = read_u32(reader)? as usize;
+                let mut budgets = HashMap::with_capacity(count);
+                for _ in 0..count {
+                    let category = read_string(reader)?;
+                    budgets.insert(category, read_u64(reader)? as usize);
+                }
+                budgets
+            },
+            consolidation_age_secs: read_u64(reader)?,
+            consolidation_importance_threshold: read_f64(reader)?,
+        };
+
+        let inference = InferenceConfig {
+            model: read_string(reader)?,
+            use_local: read_u8(reader)? != 0,
+            local_model_path: read_opt_string(reader)?,
+            api_endpoint: read_opt_string(reader)?,
+            api_key: read_opt_string(reader)?,
+            temperature: read_f32(reader)?,
+            max_tokens: read_u64(reader)? as usize,
+            timeout_ms: read_u64(reader)?,
+            fallback_api: read_opt_string(reader)?,
+            batch_window_ms: read_u64(reader)?,
+            max_batch_size: read_u64(reader)? as usize,
+            response_cache_size: read_u64(reader)? as usize,
+            response_cache_ttl_ms: read_u64(reader)?,
+            hybrid_routing: read_u8(reader)? != 0,
+            local_max_input_chars: read_u64(reader)? as usize,
+            prompt_token_budget: read_u64(reader)? as usize,
+        };
+
+        let moderation = ModerationConfig {
+            enabled: read_u8(reader)? != 0,
+            response_message: read_string(reader)?,
+            use_cloud_moderation: read_u8(reader)? != 0,
+            cloud_moderation_api_key: read_opt_string(reader)?,
+        };
+
+        let behavior_count = read_u32(reader)? as usize;
+        let mut behavior = HashMap::with_capacity(behavior_count);
+        for _ in 0..behavior_count {
+            let name = read_string(reader)?;
+            let trigger = read_string(reader)?;
+            let cooldown = read_u64(reader)?;
+            let priority = read_u32(reader)?;
+            let parameters = serde_json::from_slice(&read_bytes(reader)?)
+                .map_err(|e| std::io::Error::new(ErrorKind::InvalidData, e))?;
+            behavior.insert(name, BehaviorConfig {
+                trigger,
+                cooldown,
+                priority,
+                parameters,
+            });
+        }
+
+        let tts = if read_u8(reader)? != 0 {
+            Some(serde_json::from_slice(&read_bytes(reader)?)
+                .map_err(|e| std::io::Error::new(ErrorKind::InvalidData, e))?)
+        } else {
+            None
+        };
+
+        Ok(Self {
+            agent,
+            memory,
+            inference,
+            behavior,
+            moderation,
+            tts,
+        })
+    }
 }
 
 #[cfg(test)]
@@ -610,6 +1235,82 @@ mod tests {
         assert_eq!(deserialized.agent.role, "Tester");
     }
 
+    #[test]
+    fn test_compiled_round_trip() {
+        let mut behavior = HashMap::new();
+        behavior.insert("greeting".to_string(), BehaviorConfig {
+            trigger: "proximity".to_string(),
+            cooldown: 60,
+            priority: 10,
+            parameters: {
+                let mut params = HashMap::new();
+                params.insert("distance".to_string(), serde_json::json!(5.0));
+                params
+            },
+        });
+
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Merchant".to_string(),
+                role: "Shopkeeper".to_string(),
+                backstory: vec!["Sells potions".to_string()],
+                knowledge: vec!["Potion prices".to_string()],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig::default(),
+            behavior,
+            moderation: ModerationConfig::default(),
+            tts: None,
+        };
+
+        let path = std::env::temp_dir().join(format!(
+            "oxyde_compiled_{}.oxc",
+            crate::utils::generate_id()
+        ));
+        config.save_compiled(&path).unwrap();
+
+        let loaded = AgentConfig::from_file(&path).unwrap();
+        assert_eq!(loaded.agent.name, "Merchant");
+        assert_eq!(loaded.agent.backstory, config.agent.backstory);
+        assert_eq!(loaded.inference.model, config.inference.model);
+        assert_eq!(loaded.behavior["greeting"].trigger, "proximity");
+        assert_eq!(loaded.behavior["greeting"].parameters["distance"], serde_json::json!(5.0));
+
+        std::fs::remove_file(&path).ok();
+    }
+
+    #[test]
+    fn test_load_cached_returns_shared_config() {
+        let config = AgentConfig {
+            agent: AgentPersonality {
+                name: "Guard".to_string(),
+                role: "Guard".to_string(),
+                backstory: vec![],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig::default(),
+            behavior: HashMap::new(),
+            moderation: ModerationConfig::default(),
+            tts: None,
+        };
+
+        let path = std::env::temp_dir().join(format!(
+            "oxyde_cached_{}.json",
+            crate::utils::generate_id()
+        ));
+        config.save_to_file(&path).unwrap();
+
+        let first = AgentConfig::load_cached(&path).unwrap();
+        let second = AgentConfig::load_cached(&path).unwrap();
+
+        // The second load is served from the cache, not reparsed
+        assert!(Arc::ptr_eq(&first, &second));
+        assert_eq!(first.agent.name, "Guard");
+
+        std::fs::remove_file(&path).ok();
+    }
+
     #[test]
     fn test_memory_config_validation_success() {
         let config = MemoryConfig::default();
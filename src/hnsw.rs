@@ -0,0 +1,545 @@
+//! Approximate nearest-neighbor index for vector memory retrieval
+//!
+//! This module provides a small, self-contained HNSW (Hierarchical Navigable
+//! Small World) index used by the memory system to serve vector queries
+//! without scanning every stored embedding. Entries are keyed by string ID so
+//! they can be tied back to [`Memory`](crate::memory::Memory) records.
+//!
+//! Deletions are handled incrementally: removed entries become tombstones
+//! that stay traversable (so the graph does not disconnect) but are filtered
+//! from results, and the index rebuilds itself automatically once tombstones
+//! outnumber a fraction of live entries.
+
+use std::collections::{BinaryHeap, HashMap, HashSet};
+
+use crate::{OxydeError, Result};
+
+/// Default number of bidirectional links per node above the base layer
+const DEFAULT_M: usize = 16;
+
+/// Default size of the dynamic candidate list during construction
+const DEFAULT_EF_CONSTRUCTION: usize = 100;
+
+/// Default size of the dynamic candidate list during search
+const DEFAULT_EF_SEARCH: usize = 50;
+
+/// Rebuild once tombstones exceed this fraction of total nodes
+const TOMBSTONE_REBUILD_FRACTION: f64 = 0.25;
+
+/// Minimum number of tombstones before a rebuild is considered
+const TOMBSTONE_REBUILD_MIN: usize = 64;
+
+/// A single node in the HNSW graph
+#[derive(Debug, Clone)]
+struct Node {
+    /// External key of the entry
+    key: String,
+
+    /// The stored vector
+    vector: Vec<f32>,
+
+    /// Precomputed L2 norm of the vector
+    norm: f32,
+
+    /// Neighbor lists, one per layer the node participates in
+    layers: Vec<Vec<usize>>,
+
+    /// Whether the entry has been removed
+    deleted: bool,
+}
+
+/// A candidate during graph traversal, ordered by distance
+#[derive(Debug, PartialEq)]
+struct Candidate {
+    distance: f32,
+    index: usize,
+}
+
+impl Eq for Candidate {}
+
+impl PartialOrd for Candidate {
+    fn partial_cmp(&self, other: &Self) -> Option<std::cmp::Ordering> {
+        self.distance.partial_cmp(&other.distance)
+    }
+}
+
+impl Ord for Candidate {
+    fn cmp(&self, other: &Self) -> std::cmp::Ordering {
+        self.partial_cmp(other).unwrap_or(std::cmp::Ordering::Equal)
+    }
+}
+
+/// Hierarchical Navigable Small World index over cosine distance
+///
+/// # Example
+///
+/// ```
+/// use oxyde::hnsw::HnswIndex;
+///
+/// let mut index = HnswIndex::new(3);
+/// index.insert("a", &[1.0, 0.0, 0.0]).unwrap();
+/// index.insert("b", &[0.0, 1.0, 0.0]).unwrap();
+///
+/// let results = index.search(&[0.9, 0.1, 0.0], 1);
+/// assert_eq!(results[0].0, "a");
+/// ```
+#[derive(Debug)]
+pub struct HnswIndex {
+    /// Expected dimensionality of stored vectors
+    dimension: usize,
+
+    /// Max neighbors per node above the base layer (2M at the base layer)
+    m: usize,
+
+    /// Candidate list size during insertion
+    ef_construction: usize,
+
+    /// Candidate list size during search
+    ef_search: usize,
+
+    /// All nodes, including tombstones
+    nodes: Vec<Node>,
+
+    /// Lookup from external key to node index
+    key_index: HashMap<String, usize>,
+
+    /// Entry point into the top layer
+    entry_point: Option<usize>,
+
+    /// Number of tombstoned nodes
+    deleted_count: usize,
+
+    /// State for the layer-assignment RNG
+    rng_state: u64,
+}
+
+impl HnswIndex {
+    /// Create an empty index for vectors of the given dimension
+    pub fn new(dimension: usize) -> Self {
+        Self::with_params(dimension, DEFAULT_M, DEFAULT_EF_CONSTRUCTION, DEFAULT_EF_SEARCH)
+    }
+
+    /// Create an empty index with explicit graph parameters
+    ///
+    /// # Arguments
+    ///
+    /// * `dimension` - Expected vector dimensionality
+    /// * `m` - Max neighbors per node above the base layer
+    /// * `ef_construction` - Candidate list size during insertion
+    /// * `ef_search` - Candidate list size during search
+    pub fn with_params(dimension: usize, m: usize, ef_construction: usize, ef_search: usize) -> Self {
+        Self {
+            dimension,
+            m: m.max(2),
+            ef_construction: ef_construction.max(m),
+            ef_search: ef_search.max(1),
+            nodes: Vec::new(),
+            key_index: HashMap::new(),
+            entry_point: None,
+            deleted_count: 0,
+            rng_state: 0x5DEECE66D,
+        }
+    }
+
+    /// Number of live (non-deleted) entries
+    pub fn len(&self) -> usize {
+        self.nodes.len() - self.deleted_count
+    }
+
+    /// Whether the index has no live entries
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Insert a vector under the given key
+    ///
+    /// Re-inserting an existing key replaces its vector.
+    ///
+    /// # Arguments
+    ///
+    /// * `key` - External key of the entry
+    /// * `vector` - The vector to index
+    pub fn insert(&mut self, key: &str, vector: &[f32]) -> Result<()> {
+        if vector.len() != self.dimension {
+            return Err(OxydeError::MemoryError(format!(
+                "Vector dimension {} does not match index dimension {}",
+                vector.len(),
+                self.dimension
+            )));
+        }
+
+        // Replace an existing entry by tombstoning it first
+        if self.key_index.contains_key(key) {
+            self.remove(key);
+        }
+
+        let norm = vector.iter().map(|v| v * v).sum::<f32>().sqrt();
+        let level = self.random_level();
+        let index = self.nodes.len();
+
+        self.nodes.push(Node {
+            key: key.to_string(),
+            vector: vector.to_vec(),
+            norm,
+            layers: vec![Vec::new(); level + 1],
+            deleted: false,
+        });
+        self.key_index.insert(key.to_string(), index);
+
+        let Some(mut current) = self.entry_point else {
+            self.entry_point = Some(index);
+            return Ok(());
+        };
+
+        let top_level = self.nodes[current].layers.len() - 1;
+
+        // Greedy descent through layers above the new node's level
+        for layer in ((level + 1)..=top_level).rev() {
+            current = self.greedy_closest(vector, norm, current, layer);
+        }
+
+        // Insert into each layer from the node's level down to the base
+        for layer in (0..=level.min(top_level)).rev() {
+            let candidates = self.search_layer(vector, norm, current, self.ef_construction, layer);
+
+            let max_links = if layer == 0 { self.m * 2 } else { self.m };
+            let neighbors: Vec<usize> = candidates.iter()
+                .take(max_links)
+                .map(|c| c.index)
+                .collect();
+
+            for &neighbor in &neighbors {
+                self.nodes[index].layers[layer].push(neighbor);
+                self.nodes[neighbor].layers[layer].push(index);
+                self.prune_neighbors(neighbor, layer, max_links);
+            }
+
+            if let Some(closest) = candidates.first() {
+                current = closest.index;
+            }
+        }
+
+        // A new node above the old top layer becomes the entry point
+        if level > top_level {
+            self.entry_point = Some(index);
+        }
+
+        Ok(())
+    }
+
+    /// Remove an entry by key
+    ///
+    /// The entry becomes a tombstone that is excluded from results; the index
+    /// rebuilds itself once tombstones pile up.
+    ///
+    /// # Returns
+    ///
+    /// Whether the key was present
+    pub fn remove(&mut self, key: &str) -> bool {
+        let Some(&index) = self.key_index.get(key) else {
+            return false;
+        };
+
+        self.key_index.remove(key);
+        if !self.nodes[index].deleted {
+            self.nodes[index].deleted = true;
+            self.deleted_count += 1;
+        }
+
+        // Move the entry point off the tombstone if possible
+        if self.entry_point == Some(index) {
+            self.entry_point = self.nodes.iter()
+                .enumerate()
+                .filter(|(_, n)| !n.deleted)
+                .max_by_key(|(_, n)| n.layers.len())
+                .map(|(i, _)| i)
+                .or(Some(index));
+            if self.is_empty() {
+                self.entry_point = None;
+            }
+        }
+
+        if self.deleted_count >= TOMBSTONE_REBUILD_MIN
+            && (self.deleted_count as f64) > (self.nodes.len() as f64) * TOMBSTONE_REBUILD_FRACTION
+        {
+            self.rebuild();
+        }
+
+        true
+    }
+
+    /// Search for the k nearest live entries to a query vector
+    ///
+    /// # Arguments
+    ///
+    /// * `query` - The query vector
+    /// * `k` - Number of results to return
+    ///
+    /// # Returns
+    ///
+    /// Up to k (key, cosine similarity) pairs, most similar first
+    pub fn search(&self, query: &[f32], k: usize) -> Vec<(String, f32)> {
+        let Some(mut current) = self.entry_point else {
+            return Vec::new();
+        };
+        if query.len() != self.dimension || k == 0 {
+            return Vec::new();
+        }
+
+        let norm = query.iter().map(|v| v * v).sum::<f32>().sqrt();
+        let top_level = self.nodes[current].layers.len() - 1;
+
+        for layer in (1..=top_level).rev() {
+            current = self.greedy_closest(query, norm, current, layer);
+        }
+
+        // Over-fetch so tombstones filtered afterwards do not shrink results
+        let ef = self.ef_search.max(k * 2);
+        let candidates = self.search_layer(query, norm, current, ef, 0);
+
+        candidates.into_iter()
+            .filter(|c| !self.nodes[c.index].deleted)
+            .take(k)
+            .map(|c| (self.nodes[c.index].key.clone(), 1.0 - c.distance))
+            .collect()
+    }
+
+    /// Rebuild the graph from live entries, dropping all tombstones
+    fn rebuild(&mut self) {
+        let live: Vec<(String, Vec<f32>)> = self.nodes.iter()
+            .filter(|n| !n.deleted)
+            .map(|n| (n.key.clone(), n.vector.clone()))
+            .collect();
+
+        log::debug!("Rebuilding HNSW index with {} live entries", live.len());
+
+        self.nodes.clear();
+        self.key_index.clear();
+        self.entry_point = None;
+        self.deleted_count = 0;
+
+        for (key, vector) in live {
+            // Insertion can only fail on a dimension mismatch, which the
+            // original insert already checked
+            let _ = self.insert(&key, &vector);
+        }
+    }
+
+    /// Cosine distance between the query and a stored node
+    fn distance(&self, query: &[f32], query_norm: f32, index: usize) -> f32 {
+        let node = &self.nodes[index];
+        if query_norm == 0.0 || node.norm == 0.0 {
+            return 1.0;
+        }
+
+        let dot: f32 = query.iter().zip(node.vector.iter()).map(|(a, b)| a * b).sum();
+        1.0 - dot / (query_norm * node.norm)
+    }
+
+    /// Greedy walk to the closest node within one layer
+    fn greedy_closest(&self, query: &[f32], query_norm: f32, start: usize, layer: usize) -> usize {
+        let mut current = start;
+        let mut current_distance = self.distance(query, query_norm, current);
+
+        loop {
+            let mut improved = false;
+            if layer < self.nodes[current].layers.len() {
+                for &neighbor in &self.nodes[current].layers[layer] {
+                    let distance = self.distance(query, query_norm, neighbor);
+                    if distance < current_distance {
+                        current = neighbor;
+                        current_distance = distance;
+                        improved = true;
+                    }
+                }
+            }
+            if !improved {
+                return current;
+            }
+        }
+    }
+
+    /// Best-first search within one layer, returning up to ef candidates
+    /// sorted by ascending distance
+    fn search_layer(&self, query: &[f32], query_norm: f32, entry: usize, ef: usize, layer: usize) -> Vec<Candidate> {
+        let mut visited = HashSet::new();
+        visited.insert(entry);
+
+        let entry_distance = self.distance(query, query_norm, entry);
+
+        // Min-heap of nodes to expand, max-heap of the best ef found so far
+        let mut to_expand = BinaryHeap::new();
+        to_expand.push(std::cmp::Reverse(Candidate { distance: entry_distance, index: entry }));
+
+        let mut best: BinaryHeap<Candidate> = BinaryHeap::new();
+        best.push(Candidate { distance: entry_distance, index: entry });
+
+        while let Some(std::cmp::Reverse(candidate)) = to_expand.pop() {
+            let worst_best = best.peek().map(|c| c.distance).unwrap_or(f32::INFINITY);
+            if candidate.distance > worst_best && best.len() >= ef {
+                break;
+            }
+
+            if layer < self.nodes[candidate.index].layers.len() {
+                for &neighbor in &self.nodes[candidate.index].layers[layer] {
+                    if !visited.insert(neighbor) {
+                        continue;
+                    }
+
+                    let distance = self.distance(query, query_norm, neighbor);
+                    let worst_best = best.peek().map(|c| c.distance).unwrap_or(f32::INFINITY);
+
+                    if best.len() < ef || distance < worst_best {
+                        to_expand.push(std::cmp::Reverse(Candidate { distance, index: neighbor }));
+                        best.push(Candidate { distance, index: neighbor });
+                        if best.len() > ef {
+                            best.pop();
+                        }
+                    }
+                }
+            }
+        }
+
+        let mut results = best.into_vec();
+        results.sort();
+        results
+    }
+
+    /// Trim a node's neighbor list back to the layer's link budget
+    fn prune_neighbors(&mut self, index: usize, layer: usize, max_links: usize) {
+        if self.nodes[index].layers[layer].len() <= max_links {
+            return;
+        }
+
+        let vector = self.nodes[index].vector.clone();
+        let norm = self.nodes[index].norm;
+
+        let mut neighbors: Vec<(f32, usize)> = self.nodes[index].layers[layer].iter()
+            .map(|&n| (self.distance(&vector, norm, n), n))
+            .collect();
+        neighbors.sort_by(|a, b| a.0.partial_cmp(&b.0).unwrap_or(std::cmp::Ordering::Equal));
+        neighbors.truncate(max_links);
+
+        self.nodes[index].layers[layer] = neighbors.into_iter().map(|(_, n)| n).collect();
+    }
+
+    /// Draw a random level with the standard exponential distribution
+    fn random_level(&mut self) -> usize {
+        // xorshift64* keeps the index deterministic per construction order
+        // without pulling a full RNG into the hot path
+        self.rng_state ^= self.rng_state << 13;
+        self.rng_state ^= self.rng_state >> 7;
+        self.rng_state ^= self.rng_state << 17;
+        let uniform = (self.rng_state >> 11) as f64 / (1u64 << 53) as f64;
+
+        let ml = 1.0 / (self.m as f64).ln();
+        (-uniform.max(f64::MIN_POSITIVE).ln() * ml).floor() as usize
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_insert_and_search() {
+        let mut index = HnswIndex::new(4);
+        index.insert("x", &[1.0, 0.0, 0.0, 0.0]).unwrap();
+        index.insert("y", &[0.0, 1.0, 0.0, 0.0]).unwrap();
+        index.insert("z", &[0.0, 0.0, 1.0, 0.0]).unwrap();
+
+        let results = index.search(&[0.9, 0.1, 0.0, 0.0], 2);
+        assert_eq!(results.len(), 2);
+        assert_eq!(results[0].0, "x");
+        assert!(results[0].1 > results[1].1);
+    }
+
+    #[test]
+    fn test_dimension_mismatch() {
+        let mut index = HnswIndex::new(4);
+        assert!(index.insert("x", &[1.0, 0.0]).is_err());
+    }
+
+    #[test]
+    fn test_remove_excludes_from_results() {
+        let mut index = HnswIndex::new(2);
+        index.insert("a", &[1.0, 0.0]).unwrap();
+        index.insert("b", &[0.8, 0.2]).unwrap();
+        index.insert("c", &[0.0, 1.0]).unwrap();
+        assert_eq!(index.len(), 3);
+
+        assert!(index.remove("a"));
+        assert!(!index.remove("a"));
+        assert_eq!(index.len(), 2);
+
+        let results = index.search(&[1.0, 0.0], 3);
+        assert!(results.iter().all(|(key, _)| key != "a"));
+        assert_eq!(results[0].0, "b");
+    }
+
+    #[test]
+    fn test_reinsert_replaces_vector() {
+        let mut index = HnswIndex::new(2);
+        index.insert("a", &[1.0, 0.0]).unwrap();
+        index.insert("a", &[0.0, 1.0]).unwrap();
+        assert_eq!(index.len(), 1);
+
+        let results = index.search(&[0.0, 1.0], 1);
+        assert_eq!(results[0].0, "a");
+        assert!(results[0].1 > 0.99);
+    }
+
+    #[test]
+    fn test_recall_on_larger_set() {
+        let mut index = HnswIndex::new(8);
+
+        // Deterministic pseudo-random vectors
+        let mut state: u64 = 42;
+        let mut next = move || {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            (state >> 11) as f32 / (1u64 << 53) as f32
+        };
+
+        let mut vectors = Vec::new();
+        for i in 0..500 {
+            let vector: Vec<f32> = (0..8).map(|_| next()).collect();
+            index.insert(&format!("m{}", i), &vector).unwrap();
+            vectors.push(vector);
+        }
+
+        // The exact nearest neighbor should be found for most probes
+        let mut hits = 0;
+        for probe in (0..500).step_by(50) {
+            let query = &vectors[probe];
+            let expected = format!("m{}", probe);
+            let results = index.search(query, 5);
+            if results.iter().any(|(key, _)| *key == expected) {
+                hits += 1;
+            }
+        }
+        assert!(hits >= 8, "Expected at least 8/10 recall, got {}/10", hits);
+    }
+
+    #[test]
+    fn test_tombstones_trigger_rebuild() {
+        let mut index = HnswIndex::new(2);
+        for i in 0..200 {
+            let angle = i as f32 * 0.01;
+            index.insert(&format!("m{}", i), &[angle.cos(), angle.sin()]).unwrap();
+        }
+
+        for i in 0..100 {
+            index.remove(&format!("m{}", i));
+        }
+
+        // The rebuild threshold was crossed at least once, so the node
+        // array no longer carries every tombstone
+        assert_eq!(index.len(), 100);
+        assert!(index.nodes.len() < 200, "tombstones were never compacted");
+
+        let results = index.search(&[0.0, 1.0], 5);
+        assert_eq!(results.len(), 5);
+    }
+}
@@ -34,18 +34,22 @@
 #![warn(missing_docs)]
 
 // Re-exports
-pub use agent::Agent;
+pub use agent::{Agent, AgentFactory};
 pub use config::AgentConfig;
 pub use inference::InferenceEngine;
 pub use memory::MemorySystem;
+pub use scheduler::AgentScheduler;
 
 // Modules
 pub mod audio;
 pub mod agent;
 pub mod config;
+pub mod hnsw;
 pub mod inference;
 pub mod memory;
+pub mod metrics;
 pub mod oxyde_game;
+pub mod scheduler;
 
 // Internal modules
 mod utils;
@@ -67,7 +71,9 @@ pub const VERSION: &str = env!("CARGO_PKG_VERSION");
 ///
 /// This function sets up logging and prepares the SDK for use.
 pub fn init() -> Result<()> {
-    env_logger::init();
+    // Host applications (the CLI, engine plugins) may have installed their
+    // own logger already; keep theirs rather than panicking
+    let _ = env_logger::try_init();
     log::info!("Initializing Oxyde SDK v{}", VERSION);
     Ok(())
 }
@@ -7,21 +7,22 @@
 //! with features for short-term and long-term memory management.
 
 use std::cmp::Ordering;
-use std::collections::BinaryHeap;
+use std::collections::{BinaryHeap, HashMap, HashSet, VecDeque};
+use std::fs::{File, OpenOptions};
+use std::io::{BufReader, BufWriter, ErrorKind, Read, Write};
+use std::path::Path;
+use std::sync::Arc;
 use std::time::{Duration, SystemTime, UNIX_EPOCH};
 
 use serde::{Deserialize, Serialize};
 use tokio::sync::RwLock;
 use uuid::Uuid;
 
-#[cfg(feature = "vector-memory")]
-use std::sync::Arc;
-
 #[cfg(feature = "vector-memory")]
 use tokio::sync::OnceCell;
 
 #[cfg(feature = "vector-memory")]
-use hnswlib::Hnsw;
+use crate::hnsw::HnswIndex;
 
 use crate::config::MemoryConfig;
 
@@ -34,13 +35,21 @@ use crate::{OxydeError, Result};
 pub trait EmbeddingModel {
     /// Generate embedding vector for text
     fn embed(&self, text: &str) -> Result<Vec<f32>>;
-    
+
+    /// Generate embedding vectors for a batch of texts
+    ///
+    /// Models that support true batched inference should override this;
+    /// the default falls back to one forward pass per text.
+    fn embed_batch(&self, texts: &[String]) -> Result<Vec<Vec<f32>>> {
+        texts.iter().map(|text| self.embed(text)).collect()
+    }
+
     /// Get the dimension of the embedding vectors
     fn dimension(&self) -> usize;
 }
 
 /// Simple embedding model implementation using MiniLM
-#[cfg(feature = "vector-memory")]
+#[cfg(feature = "bert-embeddings")]
 pub struct MiniLMEmbedding {
     /// The model used for generating embeddings
     model: rust_bert::pipelines::sentence_embeddings::SentenceEmbeddingsModel,
@@ -49,7 +58,7 @@ pub struct MiniLMEmbedding {
     dimension: usize,
 }
 
-#[cfg(feature = "vector-memory")]
+#[cfg(feature = "bert-embeddings")]
 impl MiniLMEmbedding {
     /// Create a new MiniLM embedding model
     pub fn new() -> Result<Self> {
@@ -66,27 +75,104 @@ impl MiniLMEmbedding {
     }
 }
 
-#[cfg(feature = "vector-memory")]
+#[cfg(feature = "bert-embeddings")]
 impl EmbeddingModel for MiniLMEmbedding {
     fn embed(&self, text: &str) -> Result<Vec<f32>> {
         let embeddings = self.model.encode(&[text])
             .map_err(|e| OxydeError::MemoryError(format!("Failed to generate embedding: {}", e)))?;
-        
+
         if embeddings.is_empty() {
             return Err(OxydeError::MemoryError("Empty embedding generated".to_string()));
         }
-        
+
         // Convert from Vec<f64> to Vec<f32>
         let embedding: Vec<f32> = embeddings[0].iter().map(|&x| x as f32).collect();
-        
+
         Ok(embedding)
     }
-    
+
+    fn embed_batch(&self, texts: &[String]) -> Result<Vec<Vec<f32>>> {
+        // encode() takes a slice, so a batch shares one forward pass
+        let embeddings = self.model.encode(texts)
+            .map_err(|e| OxydeError::MemoryError(format!("Failed to generate embeddings: {}", e)))?;
+
+        if embeddings.len() != texts.len() {
+            return Err(OxydeError::MemoryError(
+                "Embedding batch size mismatch".to_string(),
+            ));
+        }
+
+        Ok(embeddings.iter()
+            .map(|embedding| embedding.iter().map(|&x| x as f32).collect())
+            .collect())
+    }
+
     fn dimension(&self) -> usize {
         self.dimension
     }
 }
 
+/// Preprocessed query terms shared across a batch of relevance scores
+///
+/// Lowercasing and splitting the query once per retrieval instead of once per
+/// memory keeps the scoring loop allocation-free for the query side.
+#[derive(Debug)]
+struct QueryTerms {
+    /// Lowercased query text
+    lower: String,
+
+    /// Lowercased query words
+    words: Vec<String>,
+}
+
+impl QueryTerms {
+    /// Preprocess a query for repeated scoring
+    fn new(query: &str) -> Self {
+        let lower = query.to_lowercase();
+        let words = lower.split_whitespace().map(String::from).collect();
+        Self { lower, words }
+    }
+}
+
+/// Magic bytes identifying an Oxyde memory snapshot or journal file
+const SNAPSHOT_MAGIC: &[u8; 4] = b"OXMS";
+
+/// Current version of the binary snapshot format
+const SNAPSHOT_VERSION: u32 = 1;
+
+/// Magic bytes identifying a tagged memory journal file
+const JOURNAL_MAGIC: &[u8; 4] = b"OXMJ";
+
+/// Current version of the tagged journal format
+const JOURNAL_VERSION: u32 = 1;
+
+/// Journal record tag: a memory accepted by `add`
+const JOURNAL_RECORD_ADD: u8 = 1;
+
+/// Journal record tag: a tombstone for a removed memory id
+const JOURNAL_RECORD_REMOVE: u8 = 2;
+
+/// Write a length-prefixed byte slice to a binary record stream
+pub(crate) fn write_bytes<W: Write>(writer: &mut W, bytes: &[u8]) -> std::io::Result<()> {
+    writer.write_all(&(bytes.len() as u32).to_le_bytes())?;
+    writer.write_all(bytes)
+}
+
+/// Read a length-prefixed byte vector from a binary record stream
+pub(crate) fn read_bytes<R: Read>(reader: &mut R) -> std::io::Result<Vec<u8>> {
+    let mut len_buf = [0u8; 4];
+    reader.read_exact(&mut len_buf)?;
+    let mut buf = vec![0u8; u32::from_le_bytes(len_buf) as usize];
+    reader.read_exact(&mut buf)?;
+    Ok(buf)
+}
+
+/// Read a length-prefixed UTF-8 string from a binary record stream
+pub(crate) fn read_string<R: Read>(reader: &mut R) -> std::io::Result<String> {
+    String::from_utf8(read_bytes(reader)?)
+        .map_err(|e| std::io::Error::new(ErrorKind::InvalidData, e))
+}
+
 /// Memory category for different types of memories
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
 pub enum MemoryCategory {
@@ -121,6 +207,27 @@ impl MemoryCategory {
             Self::Emotional => "emotional",
         }
     }
+
+    /// Convert to the numeric tag used by the binary snapshot format
+    fn as_u8(&self) -> u8 {
+        match self {
+            Self::Episodic => 0,
+            Self::Semantic => 1,
+            Self::Procedural => 2,
+            Self::Emotional => 3,
+        }
+    }
+
+    /// Convert from the numeric tag used by the binary snapshot format
+    fn from_u8(tag: u8) -> Option<Self> {
+        match tag {
+            0 => Some(Self::Episodic),
+            1 => Some(Self::Semantic),
+            2 => Some(Self::Procedural),
+            3 => Some(Self::Emotional),
+            _ => None,
+        }
+    }
 }
 
 /// Memory represents a single piece of information that an agent remembers
@@ -249,23 +356,31 @@ impl Memory {
     ///
     /// Relevance score (0.0 - 1.0)
     pub fn relevance(&self, query: &str, query_embedding: Option<&[f32]>) -> f64 {
+        self.relevance_to_terms(&QueryTerms::new(query), query_embedding)
+    }
+
+    /// Calculate relevance against a preprocessed query
+    ///
+    /// This is the batch scoring kernel used by retrieval: the query side is
+    /// preprocessed once, and the embedding similarity is written as plain
+    /// slice reductions the compiler can vectorize.
+    fn relevance_to_terms(&self, terms: &QueryTerms, query_embedding: Option<&[f32]>) -> f64 {
         // If we have embeddings for both the query and the memory, use vector similarity
         if let (Some(query_vec), Some(memory_vec)) = (query_embedding, &self.embedding) {
             if query_vec.len() == memory_vec.len() {
-                // Cosine similarity calculation
-                let mut dot_product = 0.0;
-                let mut query_magnitude = 0.0;
-                let mut memory_magnitude = 0.0;
-                
-                for i in 0..query_vec.len() {
-                    dot_product += query_vec[i] as f64 * memory_vec[i] as f64;
-                    query_magnitude += (query_vec[i] as f64).powi(2);
-                    memory_magnitude += (memory_vec[i] as f64).powi(2);
-                }
-                
-                query_magnitude = query_magnitude.sqrt();
-                memory_magnitude = memory_magnitude.sqrt();
-                
+                // Cosine similarity as three dense reductions over the vectors
+                let dot_product: f64 = query_vec.iter().zip(memory_vec.iter())
+                    .map(|(q, m)| *q as f64 * *m as f64)
+                    .sum();
+                let query_magnitude: f64 = query_vec.iter()
+                    .map(|q| (*q as f64) * (*q as f64))
+                    .sum::<f64>()
+                    .sqrt();
+                let memory_magnitude: f64 = memory_vec.iter()
+                    .map(|m| (*m as f64) * (*m as f64))
+                    .sum::<f64>()
+                    .sqrt();
+
                 if query_magnitude > 0.0 && memory_magnitude > 0.0 {
                     let cosine_similarity = dot_product / (query_magnitude * memory_magnitude);
                     // Apply importance and recency bias
@@ -274,36 +389,33 @@ impl Memory {
                 }
             }
         }
-        
+
         // Fallback to keyword-based relevance if embeddings aren't available
-        let query_lower = query.to_lowercase();
-        let query_words: Vec<&str> = query_lower.split_whitespace().collect();
-        
         let content_lower = self.content.to_lowercase();
         let content_words: Vec<&str> = content_lower.split_whitespace().collect();
-        
+
         // Check for tag matches to improve relevance
         let tag_match_bonus = self.tags.iter()
-            .filter(|tag| query_lower.contains(&tag.to_lowercase()))
+            .filter(|tag| terms.lower.contains(&tag.to_lowercase()))
             .count() as f64 * 0.1;
-        
+
         // Check for content word matches
         let mut matches = 0;
-        for qw in &query_words {
-            if content_words.iter().any(|cw| cw.contains(qw)) {
+        for qw in &terms.words {
+            if content_words.iter().any(|cw| cw.contains(qw.as_str())) {
                 matches += 1;
             }
         }
-        
-        if query_words.is_empty() {
+
+        if terms.words.is_empty() {
             tag_match_bonus.min(1.0) // Just use tag bonus if query is empty
         } else {
-            let word_match_score = matches as f64 / query_words.len() as f64;
-            
+            let word_match_score = matches as f64 / terms.words.len() as f64;
+
             // Combine word matching with tag bonus and importance
             let relevance_score = (word_match_score * 0.6 + self.importance * 0.3 + tag_match_bonus)
                 .clamp(0.0, 1.0);
-            
+
             // Apply a small emotional intensity bonus for emotional memories
             if self.category == MemoryCategory::Emotional && self.emotional_intensity > 0.5 {
                 (relevance_score * 1.2).min(1.0)
@@ -321,6 +433,111 @@ impl Memory {
     pub fn set_embedding(&mut self, embedding: Vec<f32>) {
         self.embedding = Some(embedding);
     }
+
+    /// Serialize this memory as a binary snapshot record
+    ///
+    /// The record layout is length-prefixed strings followed by the fixed
+    /// numeric fields, with the embedding stored inline as raw little-endian
+    /// f32 values so it can be reloaded without re-running the embedding model.
+    fn write_binary<W: Write>(&self, writer: &mut W) -> std::io::Result<()> {
+        write_bytes(writer, self.id.as_bytes())?;
+        writer.write_all(&[self.category.as_u8()])?;
+
+        writer.write_all(&(self.tags.len() as u32).to_le_bytes())?;
+        for tag in &self.tags {
+            write_bytes(writer, tag.as_bytes())?;
+        }
+
+        write_bytes(writer, self.content.as_bytes())?;
+        writer.write_all(&self.created_at.to_le_bytes())?;
+        writer.write_all(&self.last_accessed.to_le_bytes())?;
+        writer.write_all(&self.access_count.to_le_bytes())?;
+        writer.write_all(&self.importance.to_le_bytes())?;
+        writer.write_all(&self.emotional_valence.to_le_bytes())?;
+        writer.write_all(&self.emotional_intensity.to_le_bytes())?;
+        writer.write_all(&[self.permanent as u8])?;
+
+        // Embedding dimension of 0 means no embedding is stored
+        match &self.embedding {
+            Some(embedding) => {
+                writer.write_all(&(embedding.len() as u32).to_le_bytes())?;
+                for value in embedding {
+                    writer.write_all(&value.to_le_bytes())?;
+                }
+            }
+            None => writer.write_all(&0u32.to_le_bytes())?,
+        }
+
+        Ok(())
+    }
+
+    /// Deserialize a memory from a binary snapshot record
+    fn read_binary<R: Read>(reader: &mut R) -> std::io::Result<Self> {
+        let id = read_string(reader)?;
+
+        let mut byte = [0u8; 1];
+        reader.read_exact(&mut byte)?;
+        let category = MemoryCategory::from_u8(byte[0]).ok_or_else(|| {
+            std::io::Error::new(ErrorKind::InvalidData, format!("Invalid memory category tag: {}", byte[0]))
+        })?;
+
+        let mut u32_buf = [0u8; 4];
+        reader.read_exact(&mut u32_buf)?;
+        let tag_count = u32::from_le_bytes(u32_buf) as usize;
+        let mut tags = Vec::with_capacity(tag_count);
+        for _ in 0..tag_count {
+            tags.push(read_string(reader)?);
+        }
+
+        let content = read_string(reader)?;
+
+        let mut u64_buf = [0u8; 8];
+        reader.read_exact(&mut u64_buf)?;
+        let created_at = u64::from_le_bytes(u64_buf);
+        reader.read_exact(&mut u64_buf)?;
+        let last_accessed = u64::from_le_bytes(u64_buf);
+        reader.read_exact(&mut u32_buf)?;
+        let access_count = u32::from_le_bytes(u32_buf);
+
+        reader.read_exact(&mut u64_buf)?;
+        let importance = f64::from_le_bytes(u64_buf);
+        reader.read_exact(&mut u64_buf)?;
+        let emotional_valence = f64::from_le_bytes(u64_buf);
+        reader.read_exact(&mut u64_buf)?;
+        let emotional_intensity = f64::from_le_bytes(u64_buf);
+
+        reader.read_exact(&mut byte)?;
+        let permanent = byte[0] != 0;
+
+        reader.read_exact(&mut u32_buf)?;
+        let embedding_dim = u32::from_le_bytes(u32_buf) as usize;
+        let embedding = if embedding_dim > 0 {
+            let mut values = Vec::with_capacity(embedding_dim);
+            let mut f32_buf = [0u8; 4];
+            for _ in 0..embedding_dim {
+                reader.read_exact(&mut f32_buf)?;
+                values.push(f32::from_le_bytes(f32_buf));
+            }
+            Some(values)
+        } else {
+            None
+        };
+
+        Ok(Self {
+            id,
+            category,
+            tags,
+            content,
+            created_at,
+            last_accessed,
+            access_count,
+            importance,
+            emotional_valence,
+            emotional_intensity,
+            permanent,
+            embedding,
+        })
+    }
 }
 
 impl PartialEq for Memory {
@@ -354,9 +571,46 @@ pub struct MemorySystem {
     /// Stored memories - includes both short-term and long-term
     memories: RwLock<Vec<Memory>>,
 
+    /// Append-only journal that new memories are written to when enabled
+    journal: std::sync::Mutex<Option<BufWriter<File>>>,
+
+    /// Insertion-ordered ids of recent non-permanent episodic memories
+    ///
+    /// Acts as the short-term tier: when it overflows `short_term_capacity`,
+    /// the oldest entry either graduates to long-term storage or is staged
+    /// for consolidation depending on its importance and access signals.
+    episodic_ring: std::sync::Mutex<VecDeque<String>>,
+
+    /// Aged episodic memories staged for the next consolidation pass
+    consolidation_queue: std::sync::Mutex<Vec<Memory>>,
+
+    /// Inverted keyword index over memory contents and tags
+    ///
+    /// Maps interned lowercase terms to posting lists of memory ids, so
+    /// keyword retrieval scores only memories sharing at least one term
+    /// with the query instead of tokenizing every stored content string on
+    /// every call. This is the retrieval path for builds without the
+    /// `vector-memory` feature and for queries without an embedding.
+    keyword_index: std::sync::Mutex<HashMap<String, Vec<String>>>,
+
+    /// Whether the background consolidation worker has been spawned
+    consolidation_worker_started: std::sync::atomic::AtomicBool,
+
     /// Embedding model for vector-based memory retrieval (lazily initialized)
     #[cfg(feature = "vector-memory")]
     embedding_model: OnceCell<Arc<RwLock<dyn EmbeddingModel + Send + Sync>>>,
+
+    /// Approximate nearest-neighbor index over memory embeddings
+    #[cfg(feature = "vector-memory")]
+    vector_index: std::sync::Mutex<HnswIndex>,
+
+    /// IDs of memories waiting for a background embedding pass
+    #[cfg(feature = "vector-memory")]
+    pending_embeddings: std::sync::Mutex<std::collections::VecDeque<String>>,
+
+    /// Whether the background embedding worker has been spawned
+    #[cfg(feature = "vector-memory")]
+    embedding_worker_started: std::sync::atomic::AtomicBool,
 }
 
 impl std::fmt::Debug for MemorySystem {
@@ -381,15 +635,28 @@ impl MemorySystem {
     pub fn new(config: MemoryConfig) -> Self {
         #[cfg(feature = "vector-memory")]
         return Self {
+            vector_index: std::sync::Mutex::new(HnswIndex::new(config.embedding_dimension)),
             config,
             memories: RwLock::new(Vec::new()),
+            journal: std::sync::Mutex::new(None),
+            episodic_ring: std::sync::Mutex::new(VecDeque::new()),
+            consolidation_queue: std::sync::Mutex::new(Vec::new()),
+            keyword_index: std::sync::Mutex::new(HashMap::new()),
+            consolidation_worker_started: std::sync::atomic::AtomicBool::new(false),
             embedding_model: OnceCell::new(),
+            pending_embeddings: std::sync::Mutex::new(std::collections::VecDeque::new()),
+            embedding_worker_started: std::sync::atomic::AtomicBool::new(false),
         };
 
         #[cfg(not(feature = "vector-memory"))]
         return Self {
             config,
             memories: RwLock::new(Vec::new()),
+            journal: std::sync::Mutex::new(None),
+            episodic_ring: std::sync::Mutex::new(VecDeque::new()),
+            consolidation_queue: std::sync::Mutex::new(Vec::new()),
+            keyword_index: std::sync::Mutex::new(HashMap::new()),
+            consolidation_worker_started: std::sync::atomic::AtomicBool::new(false),
         };
     }
     
@@ -408,8 +675,17 @@ impl MemorySystem {
                 // Initialize the appropriate model based on configuration
                 match self.config.embedding_model {
                     EmbeddingModelType::MiniBert => {
-                        let model = MiniLMEmbedding::new()?;
-                        Ok(Arc::new(RwLock::new(model)) as Arc<RwLock<dyn EmbeddingModel + Send + Sync>>)
+                        #[cfg(feature = "bert-embeddings")]
+                        {
+                            let model = MiniLMEmbedding::new()?;
+                            Ok(Arc::new(RwLock::new(model)) as Arc<RwLock<dyn EmbeddingModel + Send + Sync>>)
+                        }
+                        #[cfg(not(feature = "bert-embeddings"))]
+                        {
+                            Err(OxydeError::MemoryError(
+                                "MiniLM embeddings require the bert-embeddings feature".to_string(),
+                            ))
+                        }
                     }
                     EmbeddingModelType::DistilBert => {
                         Err(OxydeError::MemoryError(
@@ -433,26 +709,317 @@ impl MemorySystem {
 
         Ok(())
     }
-    
+
+    /// Lock the vector index, recovering from poison
+    #[cfg(feature = "vector-memory")]
+    fn index_lock(&self) -> std::sync::MutexGuard<'_, HnswIndex> {
+        self.vector_index.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Vector index mutex was poisoned, recovering");
+            poisoned.into_inner()
+        })
+    }
+
+    /// Insert a memory's embedding into the vector index
+    #[cfg(feature = "vector-memory")]
+    fn index_insert(&self, memory: &Memory) {
+        if let Some(embedding) = &memory.embedding {
+            if let Err(e) = self.index_lock().insert(&memory.id, embedding) {
+                log::warn!("Failed to index memory embedding: {}", e);
+            }
+        }
+    }
+
+    /// Remove a memory from the vector index
+    #[cfg(feature = "vector-memory")]
+    fn index_remove(&self, id: &str) {
+        self.index_lock().remove(id);
+    }
+
+    /// Rebuild the vector index from a full set of memories
+    #[cfg(feature = "vector-memory")]
+    fn index_rebuild(&self, memories: &[Memory]) {
+        let mut index = HnswIndex::new(self.config.embedding_dimension);
+        for memory in memories {
+            if let Some(embedding) = &memory.embedding {
+                if let Err(e) = index.insert(&memory.id, embedding) {
+                    log::warn!("Failed to index memory embedding: {}", e);
+                }
+            }
+        }
+        *self.index_lock() = index;
+    }
+
+    /// Embed one batch of pending memories
+    ///
+    /// Drains up to one batch from the pending queue, runs the embedding
+    /// model over the whole batch in a single forward pass, then attaches
+    /// the embeddings and indexes them. Memories forgotten while queued are
+    /// skipped.
+    ///
+    /// # Returns
+    ///
+    /// Number of memories embedded in this pass
     #[cfg(feature = "vector-memory")]
-    async fn generate_embedding(&self, text: &str) -> Result<Option<Vec<f32>>> {
+    pub async fn process_pending_embeddings(&self) -> Result<usize> {
+        /// How many memories are embedded per forward pass
+        const EMBEDDING_BATCH_SIZE: usize = 32;
+
         if !self.config.use_embeddings {
-            return Ok(None);
+            return Ok(0);
+        }
+
+        let batch: Vec<String> = {
+            let mut pending = self.pending_embeddings.lock().unwrap_or_else(|poisoned| {
+                log::warn!("Pending embeddings mutex was poisoned, recovering");
+                poisoned.into_inner()
+            });
+            let take = pending.len().min(EMBEDDING_BATCH_SIZE);
+            pending.drain(..take).collect()
+        };
+
+        if batch.is_empty() {
+            return Ok(0);
+        }
+
+        // Resolve the queued IDs to their current contents
+        let texts: Vec<(String, String)> = {
+            let memories = self.memories.read().await;
+            batch.into_iter()
+                .filter_map(|id| {
+                    memories.iter()
+                        .find(|m| m.id == id)
+                        .map(|m| (id, m.content.clone()))
+                })
+                .collect()
+        };
+
+        if texts.is_empty() {
+            return Ok(0);
         }
 
-        // Ensure model is initialized
         self.ensure_embedding_model().await?;
+        let Some(model) = self.embedding_model.get() else {
+            return Ok(0);
+        };
 
-        // Get the initialized model from OnceCell
-        if let Some(model) = self.embedding_model.get() {
+        let contents: Vec<String> = texts.iter().map(|(_, content)| content.clone()).collect();
+        let embeddings = {
             let model = model.read().await;
-            let embedding = model.embed(text)?;
-            Ok(Some(embedding))
-        } else {
-            Ok(None)
+            model.embed_batch(&contents)?
+        };
+
+        // Attach the embeddings and index them
+        let mut memories = self.memories.write().await;
+        let mut embedded = 0;
+        for ((id, _), embedding) in texts.iter().zip(embeddings) {
+            if let Some(memory) = memories.iter_mut().find(|m| m.id == *id) {
+                memory.embedding = Some(embedding);
+                embedded += 1;
+            }
+        }
+        for (id, _) in &texts {
+            if let Some(memory) = memories.iter().find(|m| m.id == *id) {
+                self.index_insert(memory);
+            }
         }
+
+        Ok(embedded)
     }
-    
+
+    /// Spawn the background embedding worker
+    ///
+    /// The worker wakes every `interval_ms`, embeds pending memories in
+    /// batches, and runs until the memory system is dropped. Calling this
+    /// again after the worker is running is a no-op.
+    ///
+    /// # Arguments
+    ///
+    /// * `interval_ms` - How often the worker checks the pending queue
+    #[cfg(feature = "vector-memory")]
+    pub fn start_embedding_worker(self: &Arc<Self>, interval_ms: u64) -> Option<tokio::task::JoinHandle<()>> {
+        use std::sync::atomic::Ordering;
+
+        if self.embedding_worker_started.swap(true, Ordering::SeqCst) {
+            return None;
+        }
+
+        let system = Arc::downgrade(self);
+        Some(tokio::spawn(async move {
+            loop {
+                tokio::time::sleep(Duration::from_millis(interval_ms)).await;
+
+                // Stop once the memory system itself is gone
+                let Some(system) = system.upgrade() else {
+                    break;
+                };
+
+                if let Err(e) = system.process_pending_embeddings().await {
+                    log::warn!("Background embedding pass failed: {}", e);
+                }
+            }
+        }))
+    }
+
+    /// Run one consolidation pass
+    ///
+    /// Sweeps aged low-importance episodic memories (the `importance`,
+    /// `access_count`, and emotional-intensity signals decide what counts
+    /// as forgettable) out of long-term storage, joins them with entries
+    /// staged by short-term ring overflow, and merges one batch into a
+    /// single compact semantic memory. Together with the per-category
+    /// budgets this keeps the per-agent footprint bounded over the NPC's
+    /// lifetime.
+    ///
+    /// # Returns
+    ///
+    /// Number of episodic memories consolidated away in this pass
+    pub async fn consolidate(&self) -> Result<usize> {
+        /// How many staged memories are merged into one summary per pass
+        const CONSOLIDATION_BATCH_SIZE: usize = 16;
+
+        let now = SystemTime::now()
+            .duration_since(UNIX_EPOCH)
+            .unwrap_or_default()
+            .as_secs();
+
+        // Sweep aged forgettable episodic memories into the staging queue
+        {
+            let mut memories = self.memories.write().await;
+            let mut staged = Vec::new();
+            let mut index = 0;
+            while index < memories.len() {
+                let memory = &memories[index];
+                let forgettable = memory.category == MemoryCategory::Episodic
+                    && !memory.permanent
+                    && now.saturating_sub(memory.created_at) >= self.config.consolidation_age_secs
+                    && memory.importance < self.config.consolidation_importance_threshold
+                    && memory.access_count < 3
+                    && memory.emotional_intensity < 0.5;
+
+                if forgettable {
+                    let removed = memories.remove(index);
+                    self.keyword_index_remove(&removed);
+                    #[cfg(feature = "vector-memory")]
+                    self.index_remove(&removed.id);
+                    staged.push(removed);
+                } else {
+                    index += 1;
+                }
+            }
+
+            if !staged.is_empty() {
+                self.consolidation_lock().append(&mut staged);
+            }
+        }
+
+        // Merge one batch; a lone memory waits for company rather than
+        // producing a "summary" of itself
+        let batch: Vec<Memory> = {
+            let mut queue = self.consolidation_lock();
+            if queue.len() < 2 {
+                return Ok(0);
+            }
+            let take = queue.len().min(CONSOLIDATION_BATCH_SIZE);
+            queue.drain(..take).collect()
+        };
+
+        let merged = batch.len();
+        let summary = Self::summarize_batch(&batch);
+        self.add(summary).await?;
+
+        // The sources are only tombstoned once the summary's add record is
+        // journaled: a crash while they sit in the staging queue replays
+        // them as ordinary memories, but after the merge a replay must not
+        // resurrect them next to their own summary
+        for source in &batch {
+            self.journal_append_tombstone(&source.id);
+        }
+
+        log::debug!("Consolidated {} episodic memories into one semantic memory", merged);
+        Ok(merged)
+    }
+
+    /// Build one compact semantic memory out of a batch of episodic ones
+    fn summarize_batch(batch: &[Memory]) -> Memory {
+        /// Cap on how much of each source memory survives into the summary
+        const SNIPPET_LEN: usize = 80;
+
+        /// Cap on how many distinct tags the summary carries
+        const MAX_TAGS: usize = 8;
+
+        let mut tags: Vec<String> = Vec::new();
+        for memory in batch {
+            for tag in &memory.tags {
+                if !tags.contains(tag) {
+                    tags.push(tag.clone());
+                }
+            }
+        }
+        tags.truncate(MAX_TAGS);
+
+        let snippets: Vec<String> = batch
+            .iter()
+            .map(|m| crate::utils::truncate_string(&m.content, SNIPPET_LEN))
+            .collect();
+        let content = format!(
+            "Recollection of {} past events: {}",
+            batch.len(),
+            snippets.join("; ")
+        );
+
+        // The summary outlives its forgettable sources by a small margin
+        let importance = (batch
+            .iter()
+            .map(|m| m.importance)
+            .fold(0.0, f64::max)
+            + 0.1)
+            .min(1.0);
+        let valence = batch.iter().map(|m| m.emotional_valence).sum::<f64>() / batch.len() as f64;
+        let intensity = batch.iter().map(|m| m.emotional_intensity).fold(0.0, f64::max);
+
+        Memory::new_emotional(
+            MemoryCategory::Semantic,
+            &content,
+            importance,
+            valence,
+            intensity,
+            Some(tags),
+        )
+    }
+
+    /// Spawn the background consolidation worker
+    ///
+    /// The worker wakes every `interval_ms`, runs one consolidation pass,
+    /// and runs until the memory system is dropped. Calling this again
+    /// after the worker is running is a no-op.
+    ///
+    /// # Arguments
+    ///
+    /// * `interval_ms` - How often the worker runs a consolidation pass
+    pub fn start_consolidation_worker(self: &Arc<Self>, interval_ms: u64) -> Option<tokio::task::JoinHandle<()>> {
+        use std::sync::atomic::Ordering;
+
+        if self.consolidation_worker_started.swap(true, Ordering::SeqCst) {
+            return None;
+        }
+
+        let system = Arc::downgrade(self);
+        Some(tokio::spawn(async move {
+            loop {
+                tokio::time::sleep(Duration::from_millis(interval_ms)).await;
+
+                // Stop once the memory system itself is gone
+                let Some(system) = system.upgrade() else {
+                    break;
+                };
+
+                if let Err(e) = system.consolidate().await {
+                    log::warn!("Background consolidation pass failed: {}", e);
+                }
+            }
+        }))
+    }
+
     /// Add a memory to the system
     ///
     /// # Arguments
@@ -462,17 +1029,56 @@ impl MemorySystem {
     /// # Returns
     ///
     /// Success or error
-    pub async fn add(&self, #[cfg_attr(not(feature = "vector-memory"), allow(unused_mut))] mut memory: Memory) -> Result<()> {
-        // Generate embedding for the memory if vector embeddings are enabled
+    pub async fn add(&self, memory: Memory) -> Result<()> {
+        // Queue the memory for the background embedding pass instead of
+        // paying the embedding model's forward pass on the caller's path;
+        // until then the memory is retrievable via keyword scoring
         #[cfg(feature = "vector-memory")]
         if self.config.use_embeddings && memory.embedding.is_none() {
-            if let Some(embedding) = self.generate_embedding(&memory.content).await? {
-                memory.embedding = Some(embedding);
-            }
+            let mut pending = self.pending_embeddings.lock().unwrap_or_else(|poisoned| {
+                log::warn!("Pending embeddings mutex was poisoned, recovering");
+                poisoned.into_inner()
+            });
+            pending.push_back(memory.id.clone());
         }
 
+        // Record the memory in the append-only journal before it becomes
+        // visible, so a crash between ticks never loses an acknowledged add
+        self.journal_append(&memory)?;
+
         let mut memories = self.memories.write().await;
-        
+
+        // Hard per-category budget: a category at its budget evicts its own
+        // least valuable entry instead of growing or displacing others
+        if !memory.permanent {
+            if let Some(budget) = self.config.budget_for(memory.category) {
+                let category_count = memories.iter()
+                    .filter(|m| m.category == memory.category && !m.permanent)
+                    .count();
+
+                if category_count >= budget {
+                    if let Some(index) = memories.iter()
+                        .enumerate()
+                        .filter(|(_, m)| !m.permanent && m.category == memory.category)
+                        .min_by(|(_, a), (_, b)| {
+                            let a_score = a.importance * (1.0 + a.access_count as f64 / 10.0)
+                                * (1.0 + a.emotional_intensity);
+                            let b_score = b.importance * (1.0 + b.access_count as f64 / 10.0)
+                                * (1.0 + b.emotional_intensity);
+                            a_score.partial_cmp(&b_score).unwrap_or(Ordering::Equal)
+                        })
+                        .map(|(i, _)| i)
+                    {
+                        let evicted = memories.remove(index);
+                        self.keyword_index_remove(&evicted);
+                        #[cfg(feature = "vector-memory")]
+                        self.index_remove(&evicted.id);
+                        self.journal_append_tombstone(&evicted.id);
+                    }
+                }
+            }
+        }
+
         // Check if we need to remove a memory to stay under capacity
         if !memory.permanent && memories.len() >= self.config.capacity {
             // First try to remove a memory with the same category if we have too many
@@ -496,8 +1102,13 @@ impl MemorySystem {
                     })
                     .map(|(i, _)| i)
                 {
-                    memories.remove(index);
-                    memories.push(memory);
+                    let evicted = memories.remove(index);
+                    self.keyword_index_remove(&evicted);
+                    #[cfg(feature = "vector-memory")]
+                    self.index_remove(&evicted.id);
+                    self.journal_append_tombstone(&evicted.id);
+
+                    self.finish_insert(memory, &mut memories);
                     return Ok(());
                 }
             }
@@ -517,31 +1128,191 @@ impl MemorySystem {
                 })
                 .map(|(i, _)| i)
             {
-                memories.remove(index);
+                let evicted = memories.remove(index);
+                self.keyword_index_remove(&evicted);
+                #[cfg(feature = "vector-memory")]
+                self.index_remove(&evicted.id);
+                self.journal_append_tombstone(&evicted.id);
             } else {
                 return Err(OxydeError::MemoryError(
                     "Memory capacity reached and all memories are permanent".to_string()
                 ));
             }
         }
-        
-        memories.push(memory);
+
+        self.finish_insert(memory, &mut memories);
         Ok(())
     }
-    
-    /// Retrieve a memory by ID
-    ///
-    /// # Arguments
-    ///
-    /// * `id` - ID of the memory to retrieve
-    ///
-    /// # Returns
-    ///
-    /// The memory if found, or None
-    pub async fn get(&self, id: &str) -> Option<Memory> {
-        let mut memories = self.memories.write().await;
-        
-        if let Some(index) = memories.iter().position(|m| m.id == id) {
+
+    /// Insert a memory into storage, tracking episodic entries in the
+    /// short-term ring
+    ///
+    /// When the ring overflows `short_term_capacity`, the oldest entry
+    /// either graduates to plain long-term storage (important, frequently
+    /// touched, or emotionally intense memories) or is moved out of storage
+    /// into the consolidation queue for the next background pass.
+    fn finish_insert(&self, memory: Memory, memories: &mut Vec<Memory>) {
+        self.keyword_index_insert(&memory);
+        #[cfg(feature = "vector-memory")]
+        self.index_insert(&memory);
+
+        let ring_tracked = memory.category == MemoryCategory::Episodic && !memory.permanent;
+        let id = memory.id.clone();
+        memories.push(memory);
+
+        if !ring_tracked {
+            return;
+        }
+
+        let mut ring = self.ring_lock();
+        ring.push_back(id);
+
+        while ring.len() > self.config.short_term_capacity {
+            let Some(oldest_id) = ring.pop_front() else {
+                break;
+            };
+
+            // The memory may have been forgotten while in the ring
+            let Some(index) = memories.iter().position(|m| m.id == oldest_id) else {
+                continue;
+            };
+
+            let aged = &memories[index];
+            let graduates = aged.importance >= self.config.consolidation_importance_threshold
+                || aged.access_count >= 3
+                || aged.emotional_intensity >= 0.5;
+            if graduates {
+                // Keeps its verbatim form in long-term storage, subject to
+                // the category budget and global capacity
+                continue;
+            }
+
+            let staged = memories.remove(index);
+            self.keyword_index_remove(&staged);
+            #[cfg(feature = "vector-memory")]
+            self.index_remove(&staged.id);
+            self.consolidation_lock().push(staged);
+        }
+    }
+
+    /// Lock the short-term episodic ring, recovering from poison
+    fn ring_lock(&self) -> std::sync::MutexGuard<'_, VecDeque<String>> {
+        self.episodic_ring.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Episodic ring mutex was poisoned, recovering");
+            poisoned.into_inner()
+        })
+    }
+
+    /// Lock the consolidation queue, recovering from poison
+    fn consolidation_lock(&self) -> std::sync::MutexGuard<'_, Vec<Memory>> {
+        self.consolidation_queue.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Consolidation queue mutex was poisoned, recovering");
+            poisoned.into_inner()
+        })
+    }
+
+    /// Lock the inverted keyword index, recovering from poison
+    fn keyword_lock(&self) -> std::sync::MutexGuard<'_, HashMap<String, Vec<String>>> {
+        self.keyword_index.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Keyword index mutex was poisoned, recovering");
+            poisoned.into_inner()
+        })
+    }
+
+    /// Terms a memory is indexed under: lowercase content words plus tags
+    ///
+    /// Tags are indexed alongside content words because the scoring
+    /// kernel's tag bonus can make a memory relevant with no content word
+    /// in common with the query.
+    fn keyword_terms(memory: &Memory) -> HashSet<String> {
+        let mut terms: HashSet<String> = memory
+            .content
+            .to_lowercase()
+            .split_whitespace()
+            .map(String::from)
+            .collect();
+        for tag in &memory.tags {
+            terms.insert(tag.to_lowercase());
+        }
+        terms
+    }
+
+    /// Add a memory's terms to the inverted keyword index
+    fn keyword_index_insert(&self, memory: &Memory) {
+        let mut index = self.keyword_lock();
+        for term in Self::keyword_terms(memory) {
+            index.entry(term).or_default().push(memory.id.clone());
+        }
+    }
+
+    /// Remove a memory's postings from the inverted keyword index
+    fn keyword_index_remove(&self, memory: &Memory) {
+        let mut index = self.keyword_lock();
+        for term in Self::keyword_terms(memory) {
+            if let Some(postings) = index.get_mut(&term) {
+                postings.retain(|id| id != &memory.id);
+                if postings.is_empty() {
+                    index.remove(&term);
+                }
+            }
+        }
+    }
+
+    /// Rebuild the inverted keyword index from a full set of memories
+    fn keyword_index_rebuild(&self, memories: &[Memory]) {
+        let mut index: HashMap<String, Vec<String>> = HashMap::new();
+        for memory in memories {
+            for term in Self::keyword_terms(memory) {
+                index.entry(term).or_default().push(memory.id.clone());
+            }
+        }
+        *self.keyword_lock() = index;
+    }
+
+    /// Collect the keyword candidate set for a query
+    ///
+    /// Walks the interned term vocabulary (far smaller than the total
+    /// content) and unions the posting lists of every term that can
+    /// contribute to the scoring kernel: terms containing a query word
+    /// (the kernel's substring word match) or terms contained in the query
+    /// (its tag bonus). Memories outside the set cannot score either, so
+    /// the scoring pass costs the matching postings rather than the whole
+    /// store.
+    ///
+    /// # Returns
+    ///
+    /// The candidate memory ids, or `None` for queries with no words,
+    /// which fall back to a full scan
+    fn keyword_candidates(&self, terms: &QueryTerms) -> Option<HashSet<String>> {
+        if terms.words.is_empty() {
+            return None;
+        }
+
+        let index = self.keyword_lock();
+        let mut candidates = HashSet::new();
+        for (term, postings) in index.iter() {
+            let matches = terms.words.iter().any(|word| term.contains(word.as_str()))
+                || terms.lower.contains(term.as_str());
+            if matches {
+                candidates.extend(postings.iter().cloned());
+            }
+        }
+        Some(candidates)
+    }
+
+    /// Retrieve a memory by ID
+    ///
+    /// # Arguments
+    ///
+    /// * `id` - ID of the memory to retrieve
+    ///
+    /// # Returns
+    ///
+    /// The memory if found, or None
+    pub async fn get(&self, id: &str) -> Option<Memory> {
+        let mut memories = self.memories.write().await;
+        
+        if let Some(index) = memories.iter().position(|m| m.id == id) {
             let mut memory = memories[index].clone();
             memory.touch();
             memories[index] = memory.clone();
@@ -621,46 +1392,90 @@ impl MemorySystem {
     ///
     /// Vector of relevant memories, sorted by relevance
     pub async fn retrieve_relevant(&self, query: &str, limit: usize, query_embedding: Option<&[f32]>) -> Result<Vec<Memory>> {
+        let retrieval_started = std::time::Instant::now();
         let mut memories = self.memories.write().await;
         let now = SystemTime::now()
             .duration_since(UNIX_EPOCH)
             .unwrap_or(Duration::from_secs(0))
             .as_secs();
-        
-        // Check if we should prioritize certain categories of memories
-        let has_priority_categories = !self.config.priority_categories.is_empty();
-        
-        // Define a custom struct for scored memories that implements Ord
-        #[derive(Debug, Clone, PartialEq)]
-        struct ScoredMemory {
-            score: f64,
-            memory: Memory,
-            category_priority_bonus: f64,
+
+        // Resolve priority categories once rather than re-parsing per memory
+        let priority_categories: Vec<MemoryCategory> = self.config.priority_categories.iter()
+            .filter_map(|c| MemoryCategory::from_str(c))
+            .collect();
+
+        // Preprocess the query once for the whole scoring pass
+        let terms = QueryTerms::new(query);
+
+        // With a query embedding, use the HNSW index to narrow the scoring
+        // pass to an approximate nearest-neighbor candidate set; only those
+        // candidates are re-ranked with importance/recency below.
+        #[cfg(feature = "vector-memory")]
+        let ann_candidates: Option<std::collections::HashSet<String>> = query_embedding
+            .and_then(|embedding| {
+                let index = self.index_lock();
+                if index.is_empty() {
+                    return None;
+                }
+                // Over-fetch so threshold and short-term filtering below
+                // still have enough candidates to fill the result
+                let fetch = (limit * 4).max(limit + 8);
+                Some(index.search(embedding, fetch).into_iter().map(|(id, _)| id).collect())
+            });
+
+        // Without a query embedding, the inverted keyword index narrows the
+        // scoring pass to memories sharing at least one term with the query;
+        // anything else cannot score a word match or tag bonus anyway
+        let keyword_candidates: Option<HashSet<String>> = if query_embedding.is_none() {
+            self.keyword_candidates(&terms)
+        } else {
+            None
+        };
+
+        // A retrieval candidate: the memory's index plus its total score
+        #[derive(Debug, PartialEq)]
+        struct Candidate {
+            total_score: f64,
+            index: usize,
         }
-        
-        // Implement comparison traits for ScoredMemory
-        impl PartialOrd for ScoredMemory {
+
+        impl PartialOrd for Candidate {
             fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
-                // Include the category priority bonus in the comparison
-                let self_score = self.score + self.category_priority_bonus;
-                let other_score = other.score + other.category_priority_bonus;
-                self_score.partial_cmp(&other_score)
+                self.total_score.partial_cmp(&other.total_score)
             }
         }
-        
-        impl Eq for ScoredMemory {}
-        
-        impl Ord for ScoredMemory {
+
+        impl Eq for Candidate {}
+
+        impl Ord for Candidate {
             fn cmp(&self, other: &Self) -> Ordering {
-                // Guaranteed to work since f64 always implements partial_cmp
                 self.partial_cmp(other).unwrap_or(Ordering::Equal)
             }
         }
-        
-        // Calculate relevance scores and apply time decay
-        let mut scored_memories: BinaryHeap<ScoredMemory> = BinaryHeap::new();
-        
-        for memory in memories.iter() {
+
+        // Bounded min-heap holding the current top `limit` candidates by
+        // index, so the scoring pass clones nothing and the sort phase costs
+        // O(n log k) rather than O(n log n).
+        let mut top: BinaryHeap<std::cmp::Reverse<Candidate>> = BinaryHeap::with_capacity(limit + 1);
+
+        for (index, memory) in memories.iter().enumerate() {
+            // Indexed memories outside the ANN candidate set are skipped
+            // unscored; memories still waiting for their embedding fall
+            // through to keyword scoring
+            #[cfg(feature = "vector-memory")]
+            if let Some(candidates) = &ann_candidates {
+                if memory.embedding.is_some() && !candidates.contains(&memory.id) {
+                    continue;
+                }
+            }
+
+            // Memories sharing no term with the query are skipped unscored
+            if let Some(candidates) = &keyword_candidates {
+                if !candidates.contains(&memory.id) {
+                    continue;
+                }
+            }
+
             // Apply recency bias based on access count and last access time
             let recency_factor = if memory.access_count > 0 {
                 // Frequently accessed memories are more relevant
@@ -668,12 +1483,12 @@ impl MemorySystem {
                 // Recently accessed memories are more relevant
                 let last_access_age = now.saturating_sub(memory.last_accessed) as f64;
                 let last_access_factor = (-self.config.decay_rate * (last_access_age / 86400.0)).exp();
-                
+
                 0.7 + (0.3 * access_frequency * last_access_factor)
             } else {
                 1.0 // No recency bias for memories that haven't been accessed
             };
-            
+
             // Calculate time decay factor (1.0 for new memories, approaches 0 for old ones)
             let age_seconds = now.saturating_sub(memory.created_at);
             let decay_factor = if memory.permanent {
@@ -681,68 +1496,75 @@ impl MemorySystem {
             } else {
                 (-self.config.decay_rate * (age_seconds as f64 / 86400.0)).exp() // 86400 seconds in a day
             };
-            
-            // Calculate relevance using the enhanced relevance function with embeddings
-            let relevance = memory.relevance(query, query_embedding) * decay_factor * recency_factor;
-            
-            // Calculate category priority bonus
-            let category_priority_bonus = if has_priority_categories {
-                if self.config.priority_categories.iter().any(|c| {
-                    MemoryCategory::from_str(c).map_or(false, |cat| cat == memory.category)
-                }) {
-                    0.2 // Boost priority categories
-                } else {
-                    0.0
-                }
+
+            // Calculate relevance using the batch scoring kernel
+            let relevance = memory.relevance_to_terms(&terms, query_embedding) * decay_factor * recency_factor;
+
+            // Skip memories below the threshold before they reach the heap
+            if relevance < self.config.importance_threshold {
+                continue;
+            }
+
+            // Boost priority categories
+            let category_priority_bonus = if priority_categories.contains(&memory.category) {
+                0.2
             } else {
                 0.0
             };
-            
-            // Add to heap if above threshold
-            if relevance >= self.config.importance_threshold {
-                scored_memories.push(ScoredMemory {
-                    score: relevance,
-                    memory: memory.clone(),
-                    category_priority_bonus,
-                });
+
+            let candidate = Candidate {
+                total_score: relevance + category_priority_bonus,
+                index,
+            };
+
+            if top.len() < limit {
+                top.push(std::cmp::Reverse(candidate));
+            } else if let Some(std::cmp::Reverse(smallest)) = top.peek() {
+                if candidate.total_score > smallest.total_score {
+                    top.pop();
+                    top.push(std::cmp::Reverse(candidate));
+                }
             }
         }
-        
-        // Extract top memories
+
+        // Order the surviving candidates best-first
+        let mut candidates: Vec<Candidate> = top.into_iter().map(|r| r.0).collect();
+        candidates.sort_by(|a, b| {
+            b.total_score.partial_cmp(&a.total_score).unwrap_or(Ordering::Equal)
+        });
+
+        // Extract top memories, cloning only the ones actually returned
         let mut result = Vec::with_capacity(limit);
-        
+
         // Keep track of short-term and long-term memories
         let mut short_term_count = 0;
-        
-        for _ in 0..limit {
-            if let Some(scored_memory) = scored_memories.pop() {
-                // Check if we've already reached the short-term memory limit
-                let is_short_term = now.saturating_sub(scored_memory.memory.created_at) < 3600; // Less than 1 hour old
-                
-                if is_short_term && short_term_count >= self.config.short_term_capacity {
-                    // Skip this short-term memory if we've reached the limit, unless it's very important
-                    if scored_memory.memory.importance < 0.8 {
-                        continue;
-                    }
-                }
-                
-                if is_short_term {
-                    short_term_count += 1;
-                }
-                
-                // Update last_accessed for this memory
-                if let Some(index) = memories.iter().position(|m| m.id == scored_memory.memory.id) {
-                    let mut updated = memories[index].clone();
-                    updated.touch();
-                    memories[index] = updated;
+
+        for candidate in candidates {
+            let memory = &mut memories[candidate.index];
+
+            // Check if we've already reached the short-term memory limit
+            let is_short_term = now.saturating_sub(memory.created_at) < 3600; // Less than 1 hour old
+
+            if is_short_term && short_term_count >= self.config.short_term_capacity {
+                // Skip this short-term memory if we've reached the limit, unless it's very important
+                if memory.importance < 0.8 {
+                    continue;
                 }
-                
-                result.push(scored_memory.memory);
-            } else {
-                break;
             }
+
+            if is_short_term {
+                short_term_count += 1;
+            }
+
+            // Update last_accessed in place for this memory
+            memory.touch();
+            result.push(memory.clone());
         }
-        
+
+        crate::metrics::global()
+            .memory_retrieve
+            .record(retrieval_started.elapsed());
+
         Ok(result)
     }
     
@@ -764,8 +1586,12 @@ impl MemorySystem {
                     "Cannot forget a permanent memory".to_string()
                 ));
             }
-            
-            memories.remove(index);
+
+            let removed = memories.remove(index);
+            self.keyword_index_remove(&removed);
+            #[cfg(feature = "vector-memory")]
+            self.index_remove(id);
+            self.journal_append_tombstone(&removed.id);
             Ok(())
         } else {
             Err(OxydeError::MemoryError(
@@ -785,10 +1611,19 @@ impl MemorySystem {
     /// Number of memories forgotten
     pub async fn forget_by_category(&self, category: MemoryCategory) -> usize {
         let mut memories = self.memories.write().await;
-        
+
         let initial_len = memories.len();
-        memories.retain(|m| m.category != category || m.permanent);
-        
+        memories.retain(|m| {
+            let keep = m.category != category || m.permanent;
+            if !keep {
+                self.keyword_index_remove(m);
+                #[cfg(feature = "vector-memory")]
+                self.index_remove(&m.id);
+                self.journal_append_tombstone(&m.id);
+            }
+            keep
+        });
+
         initial_len - memories.len()
     }
     
@@ -803,10 +1638,19 @@ impl MemorySystem {
     /// Number of memories forgotten
     pub async fn forget_by_tag(&self, tag: &str) -> usize {
         let mut memories = self.memories.write().await;
-        
+
         let initial_len = memories.len();
-        memories.retain(|m| !m.tags.contains(&tag.to_string()) || m.permanent);
-        
+        memories.retain(|m| {
+            let keep = !m.tags.contains(&tag.to_string()) || m.permanent;
+            if !keep {
+                self.keyword_index_remove(m);
+                #[cfg(feature = "vector-memory")]
+                self.index_remove(&m.id);
+                self.journal_append_tombstone(&m.id);
+            }
+            keep
+        });
+
         initial_len - memories.len()
     }
     
@@ -817,10 +1661,26 @@ impl MemorySystem {
     /// Number of memories cleared
     pub async fn clear(&self) -> usize {
         let mut memories = self.memories.write().await;
-        
+
         let initial_len = memories.len();
-        memories.retain(|m| m.permanent);
-        
+        memories.retain(|m| {
+            if !m.permanent {
+                self.keyword_index_remove(m);
+                #[cfg(feature = "vector-memory")]
+                self.index_remove(&m.id);
+                self.journal_append_tombstone(&m.id);
+            }
+            m.permanent
+        });
+
+        self.ring_lock().clear();
+
+        // Staged memories were journaled as adds when they entered storage;
+        // discarding them must tombstone them or replay brings them back
+        for staged in self.consolidation_lock().drain(..) {
+            self.journal_append_tombstone(&staged.id);
+        }
+
         initial_len - memories.len()
     }
     
@@ -833,6 +1693,329 @@ impl MemorySystem {
         self.memories.read().await.len()
     }
 
+    /// Append a memory record to the journal if one is enabled
+    fn journal_append(&self, memory: &Memory) -> Result<()> {
+        let mut journal = self.journal.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Memory journal mutex was poisoned, recovering");
+            poisoned.into_inner()
+        });
+
+        if let Some(writer) = journal.as_mut() {
+            writer
+                .write_all(&[JOURNAL_RECORD_ADD])
+                .and_then(|_| memory.write_binary(writer))
+                .and_then(|_| writer.flush())
+                .map_err(|e| OxydeError::MemoryError(format!("Failed to append to memory journal: {}", e)))?;
+        }
+
+        Ok(())
+    }
+
+    /// Append a removal tombstone to the journal if one is enabled
+    ///
+    /// Without the tombstone, replaying the journal would resurrect a
+    /// memory that was removed after its add record was written. A failed
+    /// write is logged rather than propagated: the removal itself has
+    /// already happened, and the removal APIs report counts, not errors.
+    fn journal_append_tombstone(&self, id: &str) {
+        let mut journal = self.journal.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Memory journal mutex was poisoned, recovering");
+            poisoned.into_inner()
+        });
+
+        if let Some(writer) = journal.as_mut() {
+            let result = writer
+                .write_all(&[JOURNAL_RECORD_REMOVE])
+                .and_then(|_| write_bytes(writer, id.as_bytes()))
+                .and_then(|_| writer.flush());
+            if let Err(e) = result {
+                log::warn!("Failed to append tombstone to memory journal: {}", e);
+            }
+        }
+    }
+
+    /// Write the journal format header to an empty journal file
+    fn write_journal_header<W: Write>(writer: &mut W) -> std::io::Result<()> {
+        writer.write_all(JOURNAL_MAGIC)?;
+        writer.write_all(&JOURNAL_VERSION.to_le_bytes())?;
+        writer.flush()
+    }
+
+    /// Enable the append-only memory journal at the given path
+    ///
+    /// Once enabled, every memory accepted by [`add`](Self::add) is appended
+    /// to the journal (embeddings included) before it becomes visible, and
+    /// every removal — forgets, evictions and consolidation merges — appends
+    /// a tombstone, so replaying the journal after a restart reconstructs
+    /// the store without resurrecting deleted memories. The journal is a
+    /// stream of tagged binary records behind a small header; replay it
+    /// after loading a snapshot with [`replay_journal`](Self::replay_journal).
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Path of the journal file, created if it does not exist
+    pub fn enable_journal(&self, path: &Path) -> Result<()> {
+        let file = OpenOptions::new()
+            .append(true)
+            .create(true)
+            .open(path)
+            .map_err(|e| OxydeError::MemoryError(format!("Failed to open memory journal: {}", e)))?;
+
+        let mut writer = BufWriter::new(file);
+
+        // A fresh journal starts with the format header; appending to an
+        // existing file keeps whatever header it already has
+        let empty = writer
+            .get_ref()
+            .metadata()
+            .map(|m| m.len() == 0)
+            .unwrap_or(false);
+        if empty {
+            Self::write_journal_header(&mut writer)
+                .map_err(|e| OxydeError::MemoryError(format!("Failed to write memory journal header: {}", e)))?;
+        }
+
+        let mut journal = self.journal.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Memory journal mutex was poisoned, recovering");
+            poisoned.into_inner()
+        });
+        *journal = Some(writer);
+
+        Ok(())
+    }
+
+    /// Replay an append-only journal into the memory store
+    ///
+    /// Records are loaded directly (embeddings included) without re-running
+    /// the embedding model or capacity eviction, so re-warming after a
+    /// restart only pays for file I/O. Adds tombstoned by a later removal
+    /// record are skipped, so memories forgotten after the last snapshot
+    /// stay forgotten. A missing journal file is treated as an empty
+    /// journal; a headerless file is replayed as a legacy stream of plain
+    /// add records.
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Path of the journal file
+    ///
+    /// # Returns
+    ///
+    /// Number of memories loaded
+    pub async fn replay_journal(&self, path: &Path) -> Result<usize> {
+        let file = match File::open(path) {
+            Ok(file) => file,
+            Err(e) if e.kind() == ErrorKind::NotFound => return Ok(0),
+            Err(e) => {
+                return Err(OxydeError::MemoryError(format!("Failed to open memory journal: {}", e)));
+            }
+        };
+
+        let mut reader = BufReader::new(file);
+
+        // Distinguish the tagged format from journals written before
+        // tombstones existed, which start straight at a memory record
+        let mut magic = [0u8; 4];
+        let tagged = match reader.read_exact(&mut magic) {
+            Ok(()) if &magic == JOURNAL_MAGIC => {
+                let mut version = [0u8; 4];
+                reader
+                    .read_exact(&mut version)
+                    .map_err(|e| OxydeError::MemoryError(format!("Failed to read memory journal: {}", e)))?;
+                let version = u32::from_le_bytes(version);
+                if version != JOURNAL_VERSION {
+                    return Err(OxydeError::MemoryError(
+                        format!("Unsupported memory journal version: {}", version),
+                    ));
+                }
+                true
+            }
+            Ok(()) => {
+                // Legacy journal: rewind and replay the bytes as records
+                use std::io::Seek;
+                reader
+                    .seek(std::io::SeekFrom::Start(0))
+                    .map_err(|e| OxydeError::MemoryError(format!("Failed to read memory journal: {}", e)))?;
+                false
+            }
+            Err(e) if e.kind() == ErrorKind::UnexpectedEof => return Ok(0),
+            Err(e) => {
+                return Err(OxydeError::MemoryError(format!("Failed to read memory journal: {}", e)));
+            }
+        };
+
+        let mut loaded = Vec::new();
+        let mut tombstoned: HashSet<String> = HashSet::new();
+        loop {
+            let tag = if tagged {
+                let mut tag = [0u8; 1];
+                match reader.read_exact(&mut tag) {
+                    Ok(()) => tag[0],
+                    Err(e) if e.kind() == ErrorKind::UnexpectedEof => break,
+                    Err(e) => {
+                        return Err(OxydeError::MemoryError(format!("Failed to read memory journal: {}", e)));
+                    }
+                }
+            } else {
+                JOURNAL_RECORD_ADD
+            };
+
+            match tag {
+                JOURNAL_RECORD_ADD => match Memory::read_binary(&mut reader) {
+                    Ok(memory) => loaded.push(memory),
+                    Err(e) if !tagged && e.kind() == ErrorKind::UnexpectedEof => break,
+                    Err(e) => {
+                        return Err(OxydeError::MemoryError(format!("Failed to read memory journal: {}", e)));
+                    }
+                },
+                JOURNAL_RECORD_REMOVE => match read_string(&mut reader) {
+                    Ok(id) => {
+                        tombstoned.insert(id);
+                    }
+                    Err(e) => {
+                        return Err(OxydeError::MemoryError(format!("Failed to read memory journal: {}", e)));
+                    }
+                },
+                other => {
+                    return Err(OxydeError::MemoryError(
+                        format!("Unknown memory journal record tag: {}", other),
+                    ));
+                }
+            }
+        }
+
+        // IDs are never reused, so a flat tombstone set is enough to drop
+        // every removed add regardless of record order
+        if !tombstoned.is_empty() {
+            loaded.retain(|m| !tombstoned.contains(&m.id));
+        }
+
+        let count = loaded.len();
+        let mut memories = self.memories.write().await;
+        memories.extend(loaded);
+
+        self.keyword_index_rebuild(&memories);
+        #[cfg(feature = "vector-memory")]
+        self.index_rebuild(&memories);
+
+        Ok(count)
+    }
+
+    /// Save all memories to a compact binary snapshot
+    ///
+    /// The snapshot stores embeddings inline as raw f32 values, so reloading
+    /// it does not re-serialize JSON or re-run the embedding model. After a
+    /// successful snapshot the journal (if enabled) is truncated, since the
+    /// snapshot now covers everything in it.
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Path to write the snapshot file to
+    ///
+    /// # Returns
+    ///
+    /// Number of memories written
+    pub async fn save_snapshot(&self, path: &Path) -> Result<usize> {
+        let memories = self.memories.read().await;
+
+        let file = File::create(path)
+            .map_err(|e| OxydeError::MemoryError(format!("Failed to create memory snapshot: {}", e)))?;
+        let mut writer = BufWriter::new(file);
+
+        (|| -> std::io::Result<()> {
+            writer.write_all(SNAPSHOT_MAGIC)?;
+            writer.write_all(&SNAPSHOT_VERSION.to_le_bytes())?;
+            writer.write_all(&(memories.len() as u64).to_le_bytes())?;
+            for memory in memories.iter() {
+                memory.write_binary(&mut writer)?;
+            }
+            writer.flush()
+        })()
+        .map_err(|e| OxydeError::MemoryError(format!("Failed to write memory snapshot: {}", e)))?;
+
+        // The snapshot supersedes the journal; start it over from empty.
+        // The truncated file needs its format header back, or the records
+        // appended afterwards would form a headerless stream that the next
+        // replay misparses as a legacy journal. The file is in append mode,
+        // so the header (and later records) land at the new end of file.
+        let mut journal = self.journal.lock().unwrap_or_else(|poisoned| {
+            log::warn!("Memory journal mutex was poisoned, recovering");
+            poisoned.into_inner()
+        });
+        if let Some(writer) = journal.as_mut() {
+            writer
+                .get_mut()
+                .set_len(0)
+                .map_err(|e| OxydeError::MemoryError(format!("Failed to truncate memory journal: {}", e)))?;
+            Self::write_journal_header(writer)
+                .map_err(|e| OxydeError::MemoryError(format!("Failed to write memory journal header: {}", e)))?;
+        }
+
+        Ok(memories.len())
+    }
+
+    /// Load memories from a binary snapshot, replacing the current contents
+    ///
+    /// Embeddings stored in the snapshot are restored as-is, so a server can
+    /// re-warm a large memory store in one bulk read without touching the
+    /// embedding model.
+    ///
+    /// # Arguments
+    ///
+    /// * `path` - Path of the snapshot file
+    ///
+    /// # Returns
+    ///
+    /// Number of memories loaded
+    pub async fn load_snapshot(&self, path: &Path) -> Result<usize> {
+        let file = File::open(path)
+            .map_err(|e| OxydeError::MemoryError(format!("Failed to open memory snapshot: {}", e)))?;
+        let mut reader = BufReader::new(file);
+
+        let mut magic = [0u8; 4];
+        reader
+            .read_exact(&mut magic)
+            .map_err(|e| OxydeError::MemoryError(format!("Failed to read memory snapshot: {}", e)))?;
+        if &magic != SNAPSHOT_MAGIC {
+            return Err(OxydeError::MemoryError(
+                "Not a valid memory snapshot file".to_string(),
+            ));
+        }
+
+        let mut u32_buf = [0u8; 4];
+        reader
+            .read_exact(&mut u32_buf)
+            .map_err(|e| OxydeError::MemoryError(format!("Failed to read memory snapshot: {}", e)))?;
+        let version = u32::from_le_bytes(u32_buf);
+        if version != SNAPSHOT_VERSION {
+            return Err(OxydeError::MemoryError(format!(
+                "Unsupported memory snapshot version: {}",
+                version
+            )));
+        }
+
+        let mut u64_buf = [0u8; 8];
+        reader
+            .read_exact(&mut u64_buf)
+            .map_err(|e| OxydeError::MemoryError(format!("Failed to read memory snapshot: {}", e)))?;
+        let count = u64::from_le_bytes(u64_buf) as usize;
+
+        let mut loaded = Vec::with_capacity(count);
+        for _ in 0..count {
+            let memory = Memory::read_binary(&mut reader)
+                .map_err(|e| OxydeError::MemoryError(format!("Failed to read memory snapshot: {}", e)))?;
+            loaded.push(memory);
+        }
+
+        let mut memories = self.memories.write().await;
+        *memories = loaded;
+
+        self.keyword_index_rebuild(&memories);
+        #[cfg(feature = "vector-memory")]
+        self.index_rebuild(&memories);
+
+        Ok(count)
+    }
+
     /// Retrieve memories by emotional valence range
     ///
     /// # Arguments
@@ -1038,6 +2221,7 @@ mod tests {
             custom_model_path: None,
             embedding_dimension: 384,
             priority_categories: Vec::new(),
+            ..Default::default()
         };
 
         let system = MemorySystem::new(config);
@@ -1067,4 +2251,300 @@ mod tests {
         system.add(Memory::new(MemoryCategory::Semantic, "Fire is hot", 0.6, Some(vec!["fact".to_string()]))).await.unwrap();
         assert_eq!(system.count().await, 3); // Still 3 due to capacity limit
     }
+
+    #[tokio::test]
+    async fn test_snapshot_roundtrip() {
+        let config = MemoryConfig::default();
+        let path = std::env::temp_dir().join(format!("oxyde_snapshot_{}.bin", Uuid::new_v4()));
+
+        let system = MemorySystem::new(config.clone());
+
+        let mut memory = Memory::new_emotional(
+            MemoryCategory::Emotional,
+            "The player saved my life",
+            0.9,
+            0.8,
+            0.7,
+            Some(vec!["player".to_string(), "rescue".to_string()]),
+        );
+        memory.set_embedding(vec![0.1, -0.2, 0.3]);
+        let memory_id = memory.id.clone();
+        system.add(memory).await.unwrap();
+        system.add(Memory::new(MemoryCategory::Semantic, "The sky is blue", 0.5, None)).await.unwrap();
+
+        assert_eq!(system.save_snapshot(&path).await.unwrap(), 2);
+
+        // Reload into a fresh system and check the records survived intact
+        let restored = MemorySystem::new(config);
+        assert_eq!(restored.load_snapshot(&path).await.unwrap(), 2);
+        assert_eq!(restored.count().await, 2);
+
+        let memory = restored.get(&memory_id).await.unwrap();
+        assert_eq!(memory.content, "The player saved my life");
+        assert_eq!(memory.category, MemoryCategory::Emotional);
+        assert_eq!(memory.tags, vec!["player".to_string(), "rescue".to_string()]);
+        assert_eq!(memory.emotional_valence, 0.8);
+        assert_eq!(memory.embedding, Some(vec![0.1, -0.2, 0.3]));
+
+        std::fs::remove_file(&path).ok();
+    }
+
+    #[tokio::test]
+    async fn test_journal_replay() {
+        let config = MemoryConfig::default();
+        let path = std::env::temp_dir().join(format!("oxyde_journal_{}.bin", Uuid::new_v4()));
+
+        let system = MemorySystem::new(config.clone());
+        system.enable_journal(&path).unwrap();
+        let met = Memory::new(MemoryCategory::Episodic, "Met the player at the gate", 0.6, None);
+        let met_id = met.id.clone();
+        system.add(met).await.unwrap();
+        system.add(Memory::new(MemoryCategory::Episodic, "Traded with the player", 0.4, None)).await.unwrap();
+
+        // Simulate a restart: replay the journal into a fresh system
+        let restored = MemorySystem::new(config.clone());
+        assert_eq!(restored.replay_journal(&path).await.unwrap(), 2);
+        assert_eq!(restored.count().await, 2);
+
+        // A forget after the adds leaves a tombstone; replay must not
+        // resurrect the forgotten memory
+        system.forget(&met_id).await.unwrap();
+        let restored = MemorySystem::new(config);
+        assert_eq!(restored.replay_journal(&path).await.unwrap(), 1);
+        assert!(restored.get(&met_id).await.is_none());
+        assert_eq!(restored.count().await, 1);
+
+        // A missing journal is treated as empty
+        std::fs::remove_file(&path).ok();
+        assert_eq!(restored.replay_journal(&path).await.unwrap(), 0);
+    }
+
+    #[tokio::test]
+    async fn test_journal_survives_snapshot_truncation() {
+        let config = MemoryConfig::default();
+        let snapshot_path = std::env::temp_dir().join(format!("oxyde_snapshot_{}.bin", Uuid::new_v4()));
+        let journal_path = std::env::temp_dir().join(format!("oxyde_journal_{}.bin", Uuid::new_v4()));
+
+        let system = MemorySystem::new(config.clone());
+        system.enable_journal(&journal_path).unwrap();
+        system.add(Memory::new(MemoryCategory::Episodic, "Before the snapshot", 0.6, None)).await.unwrap();
+
+        // Snapshotting truncates the journal; records appended afterwards
+        // must still land behind a valid header
+        assert_eq!(system.save_snapshot(&snapshot_path).await.unwrap(), 1);
+        system.add(Memory::new(MemoryCategory::Episodic, "After the snapshot", 0.4, None)).await.unwrap();
+
+        // Simulate a restart: snapshot plus journal re-warm covers both
+        let restored = MemorySystem::new(config);
+        assert_eq!(restored.load_snapshot(&snapshot_path).await.unwrap(), 1);
+        assert_eq!(restored.replay_journal(&journal_path).await.unwrap(), 1);
+        assert_eq!(restored.count().await, 2);
+
+        std::fs::remove_file(&snapshot_path).ok();
+        std::fs::remove_file(&journal_path).ok();
+    }
+
+    #[tokio::test]
+    async fn test_ring_overflow_consolidates_into_summary() {
+        let config = MemoryConfig {
+            capacity: 50,
+            persistence: false,
+            short_term_capacity: 2,
+            ..Default::default()
+        };
+
+        let system = MemorySystem::new(config);
+
+        // Low-importance, never-accessed, emotionally flat episodic
+        // memories do not graduate when the ring overflows
+        for i in 0..4 {
+            system.add(Memory::new(
+                MemoryCategory::Episodic,
+                &format!("Walked past the well, lap {}", i),
+                0.1,
+                None,
+            )).await.unwrap();
+        }
+
+        // The two overflowed entries were staged out of storage
+        assert_eq!(system.count().await, 2);
+
+        // One pass merges the staged pair into a single semantic summary
+        assert_eq!(system.consolidate().await.unwrap(), 2);
+        assert_eq!(system.count().await, 3);
+
+        let summaries = system.get_by_category(MemoryCategory::Semantic).await;
+        assert_eq!(summaries.len(), 1);
+        assert!(summaries[0].content.starts_with("Recollection of 2 past events"));
+    }
+
+    #[tokio::test]
+    async fn test_category_budget_caps_category() {
+        let mut budgets = std::collections::HashMap::new();
+        budgets.insert("episodic".to_string(), 2);
+
+        let config = MemoryConfig {
+            capacity: 10,
+            persistence: false,
+            short_term_capacity: 10,
+            category_budgets: budgets,
+            ..Default::default()
+        };
+
+        let system = MemorySystem::new(config);
+
+        system.add(Memory::new(MemoryCategory::Episodic, "Saw a fox", 0.4, None)).await.unwrap();
+        system.add(Memory::new(MemoryCategory::Episodic, "Heard thunder", 0.6, None)).await.unwrap();
+        system.add(Memory::new(MemoryCategory::Episodic, "Found a coin", 0.8, None)).await.unwrap();
+
+        // The least valuable episodic memory made room; the budget does
+        // not touch other categories
+        let episodic = system.get_by_category(MemoryCategory::Episodic).await;
+        assert_eq!(episodic.len(), 2);
+        assert!(!episodic.iter().any(|m| m.content == "Saw a fox"));
+
+        system.add(Memory::new(MemoryCategory::Semantic, "Foxes hunt at dusk", 0.5, None)).await.unwrap();
+        assert_eq!(system.count().await, 3);
+    }
+
+    #[tokio::test]
+    async fn test_keyword_index_follows_adds_and_forgets() {
+        let config = MemoryConfig {
+            persistence: false,
+            use_embeddings: false,
+            ..Default::default()
+        };
+        let system = MemorySystem::new(config);
+
+        let sky = Memory::new(MemoryCategory::Semantic, "The sky is blue", 0.5, None);
+        let sky_id = sky.id.clone();
+        system.add(sky).await.unwrap();
+        system.add(Memory::new(MemoryCategory::Semantic, "The sky looks stormy", 0.5, None)).await.unwrap();
+        system.add(Memory::new(MemoryCategory::Semantic, "Water is wet", 0.5, None)).await.unwrap();
+
+        let relevant = system.retrieve_relevant("sky", 5, None).await.unwrap();
+        assert_eq!(relevant.len(), 2);
+
+        // The index preserves the kernel's substring word match: "storm"
+        // reaches "stormy" through a containing term
+        let relevant = system.retrieve_relevant("storm", 5, None).await.unwrap();
+        assert_eq!(relevant.len(), 1);
+        assert!(relevant[0].content.contains("stormy"));
+
+        // Forgetting removes the postings along with the memory
+        system.forget(&sky_id).await.unwrap();
+        let relevant = system.retrieve_relevant("sky", 5, None).await.unwrap();
+        assert_eq!(relevant.len(), 1);
+        assert!(relevant[0].content.contains("stormy"));
+    }
+
+    #[cfg(feature = "vector-memory")]
+    #[tokio::test]
+    async fn test_vector_index_serves_embedded_queries() {
+        let config = MemoryConfig {
+            persistence: false,
+            use_embeddings: false,
+            embedding_dimension: 3,
+            ..Default::default()
+        };
+        let system = MemorySystem::new(config);
+
+        let mut fox = Memory::new(MemoryCategory::Semantic, "Foxes hunt at dusk", 0.5, None);
+        fox.set_embedding(vec![1.0, 0.0, 0.0]);
+        let fox_id = fox.id.clone();
+        system.add(fox).await.unwrap();
+
+        let mut rain = Memory::new(MemoryCategory::Semantic, "Rain floods the valley", 0.5, None);
+        rain.set_embedding(vec![0.0, 1.0, 0.0]);
+        system.add(rain).await.unwrap();
+
+        let mut coin = Memory::new(MemoryCategory::Semantic, "A coin buys bread", 0.5, None);
+        coin.set_embedding(vec![0.0, 0.0, 1.0]);
+        system.add(coin).await.unwrap();
+
+        // The query shares no words with any stored content, so only the
+        // HNSW candidate set can surface the match
+        let relevant = system
+            .retrieve_relevant("unrelated text", 2, Some(&[0.9, 0.1, 0.0]))
+            .await
+            .unwrap();
+        assert!(!relevant.is_empty());
+        assert_eq!(relevant[0].id, fox_id);
+
+        // Forgetting removes the entry from the index along with the memory
+        system.forget(&fox_id).await.unwrap();
+        let relevant = system
+            .retrieve_relevant("unrelated text", 2, Some(&[0.9, 0.1, 0.0]))
+            .await
+            .unwrap();
+        assert!(relevant.iter().all(|m| m.id != fox_id));
+    }
+
+    #[cfg(feature = "vector-memory")]
+    #[tokio::test]
+    async fn test_pending_embeddings_share_one_batched_pass() {
+        use std::sync::atomic::{AtomicUsize, Ordering};
+
+        /// Counts forward passes so the test can prove a pending batch is
+        /// embedded in one call rather than one call per memory
+        struct CountingEmbedding {
+            batch_calls: Arc<AtomicUsize>,
+            single_calls: Arc<AtomicUsize>,
+        }
+
+        impl EmbeddingModel for CountingEmbedding {
+            fn embed(&self, _text: &str) -> Result<Vec<f32>> {
+                self.single_calls.fetch_add(1, Ordering::SeqCst);
+                Ok(vec![1.0, 0.0, 0.0])
+            }
+
+            fn embed_batch(&self, texts: &[String]) -> Result<Vec<Vec<f32>>> {
+                self.batch_calls.fetch_add(1, Ordering::SeqCst);
+                Ok(texts.iter().map(|_| vec![1.0, 0.0, 0.0]).collect())
+            }
+
+            fn dimension(&self) -> usize {
+                3
+            }
+        }
+
+        let config = MemoryConfig {
+            persistence: false,
+            use_embeddings: true,
+            embedding_dimension: 3,
+            ..Default::default()
+        };
+        let system = MemorySystem::new(config);
+
+        let batch_calls = Arc::new(AtomicUsize::new(0));
+        let single_calls = Arc::new(AtomicUsize::new(0));
+        let model = CountingEmbedding {
+            batch_calls: Arc::clone(&batch_calls),
+            single_calls: Arc::clone(&single_calls),
+        };
+        assert!(system
+            .embedding_model
+            .set(Arc::new(RwLock::new(model)))
+            .is_ok());
+
+        for i in 0..5 {
+            system.add(Memory::new(
+                MemoryCategory::Semantic,
+                &format!("Observation number {}", i),
+                0.5,
+                None,
+            )).await.unwrap();
+        }
+
+        // All five queued memories share a single forward pass
+        assert_eq!(system.process_pending_embeddings().await.unwrap(), 5);
+        assert_eq!(batch_calls.load(Ordering::SeqCst), 1);
+        assert_eq!(single_calls.load(Ordering::SeqCst), 0);
+
+        // The embeddings were attached and indexed
+        let memories = system.memories.read().await;
+        assert!(memories.iter().all(|m| m.embedding.is_some()));
+        drop(memories);
+        assert!(!system.index_lock().is_empty());
+    }
 }
@@ -0,0 +1,226 @@
+//! Lightweight SDK-wide metrics.
+//!
+//! The registry exposes atomic counters and fixed-bucket latency histograms
+//! for the SDK's hot paths, so shipped games can surface where time goes
+//! without attaching a profiler. Recording is a handful of relaxed atomic
+//! operations when enabled and a single atomic load when disabled, so the
+//! instrumentation is safe to leave in release builds.
+//!
+//! Snapshots are exported as JSON through [`MetricsRegistry::snapshot_json`]
+//! and the `oxyde_unity_get_metrics` / `oxyde_unreal_get_metrics` FFI calls.
+
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::time::Duration;
+
+use lazy_static::lazy_static;
+
+/// Upper bounds of the latency histogram buckets, in microseconds.
+/// Spans sub-millisecond lock waits up to second-scale cloud calls; anything
+/// slower lands in the implicit overflow bucket.
+const LATENCY_BUCKETS_US: [u64; 13] = [
+    50, 100, 250, 500, 1_000, 2_500, 5_000, 10_000, 25_000, 50_000, 100_000, 250_000, 1_000_000,
+];
+
+/// Whether metric recording is active. Checked with a single relaxed load on
+/// every record call, so disabling metrics reduces them to near-zero cost.
+static ENABLED: AtomicBool = AtomicBool::new(true);
+
+/// Enable or disable metric recording SDK-wide.
+pub fn set_enabled(enabled: bool) {
+    ENABLED.store(enabled, Ordering::Relaxed);
+}
+
+/// Check whether metric recording is active.
+pub fn enabled() -> bool {
+    ENABLED.load(Ordering::Relaxed)
+}
+
+/// Monotonically increasing event counter.
+#[derive(Debug, Default)]
+pub struct Counter(AtomicU64);
+
+impl Counter {
+    /// Increment the counter by one. No-op while metrics are disabled.
+    pub fn increment(&self) {
+        if enabled() {
+            self.0.fetch_add(1, Ordering::Relaxed);
+        }
+    }
+
+    /// Get the current count.
+    pub fn value(&self) -> u64 {
+        self.0.load(Ordering::Relaxed)
+    }
+}
+
+/// Fixed-bucket latency histogram with microsecond resolution.
+#[derive(Debug)]
+pub struct Histogram {
+    /// One slot per entry in `LATENCY_BUCKETS_US`, plus an overflow slot.
+    buckets: [AtomicU64; LATENCY_BUCKETS_US.len() + 1],
+    sum_us: AtomicU64,
+    count: AtomicU64,
+}
+
+impl Default for Histogram {
+    fn default() -> Self {
+        Self {
+            buckets: std::array::from_fn(|_| AtomicU64::new(0)),
+            sum_us: AtomicU64::new(0),
+            count: AtomicU64::new(0),
+        }
+    }
+}
+
+impl Histogram {
+    /// Record one observation. No-op while metrics are disabled.
+    pub fn record(&self, elapsed: Duration) {
+        if !enabled() {
+            return;
+        }
+        let micros = elapsed.as_micros().min(u64::MAX as u128) as u64;
+        let slot = LATENCY_BUCKETS_US
+            .iter()
+            .position(|&bound| micros <= bound)
+            .unwrap_or(LATENCY_BUCKETS_US.len());
+        self.buckets[slot].fetch_add(1, Ordering::Relaxed);
+        self.sum_us.fetch_add(micros, Ordering::Relaxed);
+        self.count.fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Get the number of recorded observations.
+    pub fn count(&self) -> u64 {
+        self.count.load(Ordering::Relaxed)
+    }
+
+    /// Get the mean observation in microseconds, or 0 with no observations.
+    pub fn mean_us(&self) -> u64 {
+        let count = self.count();
+        if count == 0 {
+            0
+        } else {
+            self.sum_us.load(Ordering::Relaxed) / count
+        }
+    }
+
+    fn snapshot(&self) -> serde_json::Value {
+        let buckets: Vec<serde_json::Value> = LATENCY_BUCKETS_US
+            .iter()
+            .map(|b| serde_json::json!(b))
+            .chain(std::iter::once(serde_json::json!("inf")))
+            .zip(self.buckets.iter())
+            .map(|(le, count)| {
+                serde_json::json!({
+                    "le_us": le,
+                    "count": count.load(Ordering::Relaxed),
+                })
+            })
+            .collect();
+
+        serde_json::json!({
+            "count": self.count(),
+            "sum_us": self.sum_us.load(Ordering::Relaxed),
+            "mean_us": self.mean_us(),
+            "buckets": buckets,
+        })
+    }
+}
+
+/// Registry of the SDK's counters and histograms.
+///
+/// All fields are recorded at fixed points inside the SDK; games read them
+/// through [`snapshot_json`](Self::snapshot_json) or the engine FFI calls.
+#[derive(Debug, Default)]
+pub struct MetricsRegistry {
+    /// End-to-end `Agent::process_input` latency.
+    pub process_input: Histogram,
+    /// Behavior filter/sort/match/execute time inside `process_input`.
+    pub behavior_dispatch: Histogram,
+    /// `MemorySystem::retrieve_relevant` latency.
+    pub memory_retrieve: Histogram,
+    /// TTS synthesis latency (cache misses only; hits are pointer copies).
+    pub tts_synthesis: Histogram,
+    /// Audio cache hits in `TTSService::synthesize_npc_speech`.
+    pub tts_cache_hits: Counter,
+    /// Audio cache misses in `TTSService::synthesize_npc_speech`.
+    pub tts_cache_misses: Counter,
+    /// Inputs rejected by content moderation.
+    pub moderation_blocks: Counter,
+}
+
+impl MetricsRegistry {
+    /// Serialize a point-in-time snapshot of every metric as JSON.
+    ///
+    /// # Returns
+    ///
+    /// A JSON object string with `counters` and `histograms` sections
+    pub fn snapshot_json(&self) -> String {
+        serde_json::json!({
+            "enabled": enabled(),
+            "counters": {
+                "tts_cache_hits": self.tts_cache_hits.value(),
+                "tts_cache_misses": self.tts_cache_misses.value(),
+                "moderation_blocks": self.moderation_blocks.value(),
+            },
+            "histograms": {
+                "process_input": self.process_input.snapshot(),
+                "behavior_dispatch": self.behavior_dispatch.snapshot(),
+                "memory_retrieve": self.memory_retrieve.snapshot(),
+                "tts_synthesis": self.tts_synthesis.snapshot(),
+            },
+        })
+        .to_string()
+    }
+}
+
+lazy_static! {
+    static ref REGISTRY: MetricsRegistry = MetricsRegistry::default();
+}
+
+/// Get the global metrics registry.
+pub fn global() -> &'static MetricsRegistry {
+    &REGISTRY
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_counter_and_histogram_record() {
+        let counter = Counter::default();
+        counter.increment();
+        counter.increment();
+        assert_eq!(counter.value(), 2);
+
+        let histogram = Histogram::default();
+        histogram.record(Duration::from_micros(75));
+        histogram.record(Duration::from_micros(125));
+        assert_eq!(histogram.count(), 2);
+        assert_eq!(histogram.mean_us(), 100);
+        // 75us lands in the le=100 bucket, 125us in the le=250 bucket
+        assert_eq!(histogram.buckets[1].load(Ordering::Relaxed), 1);
+        assert_eq!(histogram.buckets[2].load(Ordering::Relaxed), 1);
+    }
+
+    #[test]
+    fn test_overflow_bucket_catches_slow_observations() {
+        let histogram = Histogram::default();
+        histogram.record(Duration::from_secs(5));
+        let last = histogram.buckets.len() - 1;
+        assert_eq!(histogram.buckets[last].load(Ordering::Relaxed), 1);
+    }
+
+    #[test]
+    fn test_snapshot_json_shape() {
+        let registry = MetricsRegistry::default();
+        registry.tts_cache_hits.increment();
+        registry.process_input.record(Duration::from_millis(3));
+
+        let snapshot: serde_json::Value =
+            serde_json::from_str(&registry.snapshot_json()).unwrap();
+        assert_eq!(snapshot["counters"]["tts_cache_hits"], 1);
+        assert_eq!(snapshot["histograms"]["process_input"]["count"], 1);
+        assert!(snapshot["histograms"]["process_input"]["buckets"].is_array());
+    }
+}
@@ -156,6 +156,19 @@ pub trait Behavior: Send + Sync + std::fmt::Debug {
         50 // Default medium priority
     }
 
+    /// Get the fixed response strings this behavior can produce (optional)
+    ///
+    /// Behaviors whose `execute` returns constant `BehaviorResult::Response`
+    /// text can override this so agents can pre-synthesize the audio for
+    /// those lines into the TTS cache at start time.
+    ///
+    /// # Returns
+    ///
+    /// Vector of response strings eligible for audio prefetch
+    fn canned_responses(&self) -> Vec<String> {
+        Vec::new()
+    }
+
     /// Calculate dynamic priority based on emotional state
     ///
     /// Behaviors can override this to adjust priority based on emotions.
@@ -113,4 +113,8 @@ impl Behavior for GreetingBehavior {
             Ok(BehaviorResult::None)
         }
     }
+
+    fn canned_responses(&self) -> Vec<String> {
+        self.greetings.clone()
+    }
 }
@@ -44,6 +44,7 @@ mod tests {
             confidence: 1.0,
             raw_input: "".to_string(),
             keywords: vec![],
+            keyword_ids: Default::default(),
         };
 
         let mut context = HashMap::new();
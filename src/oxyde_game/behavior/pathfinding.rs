@@ -80,7 +80,7 @@ impl Behavior for PathfindingBehavior {
         }
 
         intent.intent_type == IntentType::Custom || // movement/follow are custom types
-        (intent.intent_type == IntentType::Command && intent.keywords.contains(&"follow".to_string()))
+        (intent.intent_type == IntentType::Command && intent.has_keyword("follow"))
     }
 
     async fn execute(&self, _intent: &Intent, context: &AgentContext) -> Result<BehaviorResult> {
@@ -93,7 +93,7 @@ impl Behavior for PathfindingBehavior {
         let player_y = context.get("player_y").and_then(|v| v.as_f64()).unwrap_or(0.0) as f32;
 
         // Check if we should start following
-        if _intent.intent_type == IntentType::Command && _intent.keywords.contains(&"follow".to_string()) {
+        if _intent.intent_type == IntentType::Command && _intent.has_keyword("follow") {
             // Send action to start following
             return Ok(BehaviorResult::Action(format!(
                 "follow|{:.2}|{:.2}|{:.2}",
@@ -118,6 +118,7 @@ pub trait SelectionStrategy: Send + Sync {
 ///         confidence: 0.9,
 ///         raw_input: "I'm going to hurt you!".to_string(),
 ///         keywords: vec!["hurt".to_string()],
+///         keyword_ids: Default::default(),
 ///     };
 ///
 ///     let strategy = EmotionModulatedStrategy;
@@ -331,6 +332,7 @@ mod tests {
             confidence: 0.9,
             raw_input: "I'm going to attack you!".to_string(),
             keywords: vec!["attack".to_string()],
+            keyword_ids: Default::default(),
         };
 
         let strategy = EmotionModulatedStrategy::new();
@@ -361,6 +363,7 @@ mod tests {
             confidence: 0.9,
             raw_input: "Threatening message".to_string(),
             keywords: vec!["threat".to_string()],
+            keyword_ids: Default::default(),
         };
 
         let strategy = FixedPriorityStrategy::new();
@@ -389,6 +392,7 @@ mod tests {
             confidence: 0.9,
             raw_input: "Hello".to_string(),
             keywords: vec!["hello".to_string()],
+            keyword_ids: Default::default(),
         };
 
         let strategy = EmotionModulatedStrategy::new();
@@ -0,0 +1,339 @@
+//! Binary framing for batched per-frame engine traffic
+//!
+//! With one actor component per NPC, a 150-agent crowd costs 150 separate
+//! FFI crossings per tick for context updates and response polls. This codec
+//! frames a whole frame's traffic — dirty contexts, queued inputs and
+//! outstanding response handles — into one request buffer, and the results
+//! (issued request handles plus completed responses) into one response
+//! buffer, so the engine pays a single crossing per frame regardless of
+//! crowd size.
+//!
+//! Request wire format (all integers little-endian):
+//!
+//! ```text
+//! header:  magic u16 (0x424F "OB") | version u8
+//! updates: count u16, each: id_len u16 | agent id (UTF-8)
+//!                           | ctx_len u32 | context buffer (context_codec)
+//! inputs:  count u16, each: id_len u16 | agent id (UTF-8)
+//!                           | input_len u32 | input (UTF-8)
+//! polls:   count u16, each: handle u64
+//! ```
+//!
+//! Response wire format:
+//!
+//! ```text
+//! header:    magic u16 (0x524F "OR") | version u8
+//! handles:   count u16, each: handle u64
+//!            (one per submitted input, in order; 0 marks a failed submit)
+//! completed: count u16, each: handle u64 | success u8
+//!                             | text_len u32 | response (UTF-8)
+//! ```
+
+use crate::agent::AgentContext;
+use crate::oxyde_game::bindings::context_codec::{decode_context, encode_context, Reader};
+use crate::{OxydeError, Result};
+
+/// Magic bytes opening every batch request buffer ("OB", little-endian).
+pub const BATCH_MAGIC: u16 = 0x424F;
+
+/// Magic bytes opening every batch response buffer ("OR", little-endian).
+pub const BATCH_RESPONSE_MAGIC: u16 = 0x524F;
+
+/// Current batch wire format version.
+pub const BATCH_VERSION: u8 = 1;
+
+/// One frame's worth of agent traffic, decoded from a batch request
+#[derive(Debug, Default)]
+pub struct BatchRequest {
+    /// Context updates to apply, as (agent id, decoded context) pairs
+    pub updates: Vec<(String, AgentContext)>,
+
+    /// Inputs to submit, as (agent id, input text) pairs
+    pub inputs: Vec<(String, String)>,
+
+    /// Outstanding async handles to poll for completion
+    pub polls: Vec<u64>,
+}
+
+/// A completed async response delivered in a batch response
+#[derive(Debug)]
+pub struct CompletedResponse {
+    /// The handle the response belongs to
+    pub handle: u64,
+
+    /// Response text, or the error message for failed requests
+    pub text: String,
+
+    /// Whether processing succeeded
+    pub success: bool,
+}
+
+/// Results of one batched tick, encoded into a batch response
+#[derive(Debug, Default)]
+pub struct BatchResponse {
+    /// One handle per submitted input, in submission order; 0 marks a
+    /// failed submit (unknown agent)
+    pub issued_handles: Vec<u64>,
+
+    /// Responses that completed among the polled handles
+    pub completed: Vec<CompletedResponse>,
+}
+
+/// Decode a batch request buffer
+///
+/// # Arguments
+///
+/// * `buf` - Request buffer in the format described in the module docs
+///
+/// # Returns
+///
+/// The decoded request, or a `BindingError` for malformed input
+pub fn decode_batch_request(buf: &[u8]) -> Result<BatchRequest> {
+    let mut reader = Reader { buf, pos: 0 };
+
+    let magic = reader.read_u16()?;
+    if magic != BATCH_MAGIC {
+        return Err(OxydeError::BindingError(format!(
+            "Invalid batch request magic: {:#06x}",
+            magic
+        )));
+    }
+    let version = reader.read_u8()?;
+    if version != BATCH_VERSION {
+        return Err(OxydeError::BindingError(format!(
+            "Unsupported batch request version: {}",
+            version
+        )));
+    }
+
+    let update_count = reader.read_u16()? as usize;
+    let mut updates = Vec::with_capacity(update_count);
+    for _ in 0..update_count {
+        let id_len = reader.read_u16()? as usize;
+        let agent_id = reader.read_str(id_len)?.to_string();
+        let ctx_len = reader.read_u32()? as usize;
+        let context = decode_context(reader.take(ctx_len)?)?;
+        updates.push((agent_id, context));
+    }
+
+    let input_count = reader.read_u16()? as usize;
+    let mut inputs = Vec::with_capacity(input_count);
+    for _ in 0..input_count {
+        let id_len = reader.read_u16()? as usize;
+        let agent_id = reader.read_str(id_len)?.to_string();
+        let input_len = reader.read_u32()? as usize;
+        let input = reader.read_str(input_len)?.to_string();
+        inputs.push((agent_id, input));
+    }
+
+    let poll_count = reader.read_u16()? as usize;
+    let mut polls = Vec::with_capacity(poll_count);
+    for _ in 0..poll_count {
+        polls.push(reader.read_u64()?);
+    }
+
+    Ok(BatchRequest { updates, inputs, polls })
+}
+
+/// Encode a batch request buffer
+///
+/// The inverse of [`decode_batch_request`]; used by tests and by hosts that
+/// drive the FFI from Rust.
+///
+/// # Returns
+///
+/// The encoded buffer, or a `BindingError` if a section exceeds the
+/// format's 65535-entry limit
+pub fn encode_batch_request(request: &BatchRequest) -> Result<Vec<u8>> {
+    check_section_len("updates", request.updates.len())?;
+    check_section_len("inputs", request.inputs.len())?;
+    check_section_len("polls", request.polls.len())?;
+
+    let mut buf = Vec::with_capacity(64);
+    buf.extend_from_slice(&BATCH_MAGIC.to_le_bytes());
+    buf.push(BATCH_VERSION);
+
+    buf.extend_from_slice(&(request.updates.len() as u16).to_le_bytes());
+    for (agent_id, context) in &request.updates {
+        write_short_str(&mut buf, agent_id);
+        let encoded = encode_context(context)?;
+        buf.extend_from_slice(&(encoded.len() as u32).to_le_bytes());
+        buf.extend_from_slice(&encoded);
+    }
+
+    buf.extend_from_slice(&(request.inputs.len() as u16).to_le_bytes());
+    for (agent_id, input) in &request.inputs {
+        write_short_str(&mut buf, agent_id);
+        buf.extend_from_slice(&(input.len() as u32).to_le_bytes());
+        buf.extend_from_slice(input.as_bytes());
+    }
+
+    buf.extend_from_slice(&(request.polls.len() as u16).to_le_bytes());
+    for handle in &request.polls {
+        buf.extend_from_slice(&handle.to_le_bytes());
+    }
+
+    Ok(buf)
+}
+
+/// Encode a batch response buffer
+///
+/// # Returns
+///
+/// The encoded buffer, or a `BindingError` if a section exceeds the
+/// format's 65535-entry limit
+pub fn encode_batch_response(response: &BatchResponse) -> Result<Vec<u8>> {
+    check_section_len("issued handles", response.issued_handles.len())?;
+    check_section_len("completed responses", response.completed.len())?;
+
+    let mut buf = Vec::with_capacity(32);
+    buf.extend_from_slice(&BATCH_RESPONSE_MAGIC.to_le_bytes());
+    buf.push(BATCH_VERSION);
+
+    buf.extend_from_slice(&(response.issued_handles.len() as u16).to_le_bytes());
+    for handle in &response.issued_handles {
+        buf.extend_from_slice(&handle.to_le_bytes());
+    }
+
+    buf.extend_from_slice(&(response.completed.len() as u16).to_le_bytes());
+    for completed in &response.completed {
+        buf.extend_from_slice(&completed.handle.to_le_bytes());
+        buf.push(completed.success as u8);
+        buf.extend_from_slice(&(completed.text.len() as u32).to_le_bytes());
+        buf.extend_from_slice(completed.text.as_bytes());
+    }
+
+    Ok(buf)
+}
+
+/// Decode a batch response buffer
+///
+/// The inverse of [`encode_batch_response`].
+///
+/// # Returns
+///
+/// The decoded response, or a `BindingError` for malformed input
+pub fn decode_batch_response(buf: &[u8]) -> Result<BatchResponse> {
+    let mut reader = Reader { buf, pos: 0 };
+
+    let magic = reader.read_u16()?;
+    if magic != BATCH_RESPONSE_MAGIC {
+        return Err(OxydeError::BindingError(format!(
+            "Invalid batch response magic: {:#06x}",
+            magic
+        )));
+    }
+    let version = reader.read_u8()?;
+    if version != BATCH_VERSION {
+        return Err(OxydeError::BindingError(format!(
+            "Unsupported batch response version: {}",
+            version
+        )));
+    }
+
+    let handle_count = reader.read_u16()? as usize;
+    let mut issued_handles = Vec::with_capacity(handle_count);
+    for _ in 0..handle_count {
+        issued_handles.push(reader.read_u64()?);
+    }
+
+    let completed_count = reader.read_u16()? as usize;
+    let mut completed = Vec::with_capacity(completed_count);
+    for _ in 0..completed_count {
+        let handle = reader.read_u64()?;
+        let success = reader.read_u8()? != 0;
+        let text_len = reader.read_u32()? as usize;
+        let text = reader.read_str(text_len)?.to_string();
+        completed.push(CompletedResponse { handle, text, success });
+    }
+
+    Ok(BatchResponse { issued_handles, completed })
+}
+
+/// Reject sections too large for their u16 count field
+fn check_section_len(section: &str, len: usize) -> Result<()> {
+    if len > u16::MAX as usize {
+        return Err(OxydeError::BindingError(format!(
+            "Batch {} section has {} entries, format supports at most {}",
+            section,
+            len,
+            u16::MAX
+        )));
+    }
+    Ok(())
+}
+
+/// Write a length-prefixed short string (u16 length)
+fn write_short_str(buf: &mut Vec<u8>, s: &str) {
+    buf.extend_from_slice(&(s.len() as u16).to_le_bytes());
+    buf.extend_from_slice(s.as_bytes());
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_batch_request_round_trip() {
+        let mut context = AgentContext::new();
+        context.insert("health".to_string(), serde_json::json!(80));
+        context.insert("zone".to_string(), serde_json::json!("market"));
+
+        let request = BatchRequest {
+            updates: vec![("agent-1".to_string(), context.clone())],
+            inputs: vec![
+                ("agent-1".to_string(), "Hello".to_string()),
+                ("agent-2".to_string(), "Any news?".to_string()),
+            ],
+            polls: vec![7, 42],
+        };
+
+        let encoded = encode_batch_request(&request).unwrap();
+        let decoded = decode_batch_request(&encoded).unwrap();
+
+        assert_eq!(decoded.updates.len(), 1);
+        assert_eq!(decoded.updates[0].0, "agent-1");
+        assert_eq!(decoded.updates[0].1, context);
+        assert_eq!(decoded.inputs, request.inputs);
+        assert_eq!(decoded.polls, request.polls);
+    }
+
+    #[test]
+    fn test_batch_response_round_trip() {
+        let response = BatchResponse {
+            issued_handles: vec![3, 0, 4],
+            completed: vec![
+                CompletedResponse {
+                    handle: 7,
+                    text: "Fine weather today".to_string(),
+                    success: true,
+                },
+                CompletedResponse {
+                    handle: 42,
+                    text: "Error processing input: timeout".to_string(),
+                    success: false,
+                },
+            ],
+        };
+
+        let encoded = encode_batch_response(&response).unwrap();
+        let decoded = decode_batch_response(&encoded).unwrap();
+
+        assert_eq!(decoded.issued_handles, response.issued_handles);
+        assert_eq!(decoded.completed.len(), 2);
+        assert_eq!(decoded.completed[0].handle, 7);
+        assert!(decoded.completed[0].success);
+        assert_eq!(decoded.completed[1].text, "Error processing input: timeout");
+        assert!(!decoded.completed[1].success);
+    }
+
+    #[test]
+    fn test_malformed_batch_buffers_are_rejected() {
+        assert!(decode_batch_request(&[]).is_err());
+        assert!(decode_batch_request(&[0x00, 0x00, 1]).is_err()); // bad magic
+
+        let encoded = encode_batch_request(&BatchRequest::default()).unwrap();
+        assert!(decode_batch_request(&encoded[..encoded.len() - 1]).is_err()); // truncated
+        assert!(decode_batch_response(&encoded).is_err()); // wrong magic for responses
+    }
+}
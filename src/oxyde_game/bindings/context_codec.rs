@@ -0,0 +1,260 @@
+//! Compact binary encoding for agent context updates
+//!
+//! Context updates (position, health, state) are the highest-frequency FFI
+//! call — engines push them for every agent every few frames — and routing
+//! them through JSON means serialize-parse-allocate in a loop. This codec
+//! replaces that hot path with a flat typed layout that decodes without any
+//! intermediate tree; complex values can still fall back to an embedded JSON
+//! field.
+//!
+//! Wire format (all integers little-endian):
+//!
+//! ```text
+//! header:  magic u16 (0x584F "OX") | version u8 | field_count u8
+//! field:   key_len u16 | key bytes (UTF-8) | type tag u8 | payload
+//! payload: Bool   -> u8 (0/1)
+//!          Int    -> i64
+//!          Float  -> f64
+//!          String -> len u32 | bytes (UTF-8)
+//!          Json   -> len u32 | bytes (UTF-8 JSON document)
+//! ```
+//!
+//! Keys are written inline per field; the key sets of real context updates
+//! are small and unique, so a shared string table would only add an
+//! indirection to every decode.
+
+use crate::agent::AgentContext;
+use crate::{OxydeError, Result};
+
+/// Magic bytes opening every binary context buffer ("OX", little-endian).
+pub const CONTEXT_MAGIC: u16 = 0x584F;
+
+/// Current wire format version.
+pub const CONTEXT_VERSION: u8 = 1;
+
+/// Field type tags.
+const TAG_BOOL: u8 = 1;
+const TAG_INT: u8 = 2;
+const TAG_FLOAT: u8 = 3;
+const TAG_STRING: u8 = 4;
+const TAG_JSON: u8 = 5;
+
+/// Decode a binary context buffer into an `AgentContext`
+///
+/// # Arguments
+///
+/// * `buf` - Binary context buffer in the format described in the module docs
+///
+/// # Returns
+///
+/// The decoded context, or a `BindingError` for malformed input
+pub fn decode_context(buf: &[u8]) -> Result<AgentContext> {
+    let mut reader = Reader { buf, pos: 0 };
+
+    let magic = reader.read_u16()?;
+    if magic != CONTEXT_MAGIC {
+        return Err(OxydeError::BindingError(format!(
+            "Invalid binary context magic: {:#06x}",
+            magic
+        )));
+    }
+    let version = reader.read_u8()?;
+    if version != CONTEXT_VERSION {
+        return Err(OxydeError::BindingError(format!(
+            "Unsupported binary context version: {}",
+            version
+        )));
+    }
+    let field_count = reader.read_u8()?;
+
+    let mut context = AgentContext::new();
+    for _ in 0..field_count {
+        let key_len = reader.read_u16()? as usize;
+        let key = reader.read_str(key_len)?.to_string();
+
+        let tag = reader.read_u8()?;
+        let value = match tag {
+            TAG_BOOL => serde_json::Value::Bool(reader.read_u8()? != 0),
+            TAG_INT => serde_json::json!(reader.read_i64()?),
+            TAG_FLOAT => serde_json::json!(reader.read_f64()?),
+            TAG_STRING => {
+                let len = reader.read_u32()? as usize;
+                serde_json::Value::String(reader.read_str(len)?.to_string())
+            }
+            TAG_JSON => {
+                let len = reader.read_u32()? as usize;
+                serde_json::from_str(reader.read_str(len)?).map_err(|e| {
+                    OxydeError::BindingError(format!(
+                        "Invalid JSON fallback value for context key '{}': {}",
+                        key, e
+                    ))
+                })?
+            }
+            other => {
+                return Err(OxydeError::BindingError(format!(
+                    "Unknown binary context field tag: {}",
+                    other
+                )))
+            }
+        };
+        context.insert(key, value);
+    }
+
+    Ok(context)
+}
+
+/// Encode an `AgentContext` into the binary wire format
+///
+/// The inverse of [`decode_context`]; bools, integers, floats, and strings
+/// use their typed encodings, everything else falls back to an embedded JSON
+/// field.
+///
+/// # Returns
+///
+/// The encoded buffer, or a `BindingError` if the context holds more fields
+/// than the format's 255-field limit
+pub fn encode_context(context: &AgentContext) -> Result<Vec<u8>> {
+    if context.len() > u8::MAX as usize {
+        return Err(OxydeError::BindingError(format!(
+            "Context has {} fields, binary format supports at most {}",
+            context.len(),
+            u8::MAX
+        )));
+    }
+
+    let mut buf = Vec::with_capacity(4 + context.len() * 16);
+    buf.extend_from_slice(&CONTEXT_MAGIC.to_le_bytes());
+    buf.push(CONTEXT_VERSION);
+    buf.push(context.len() as u8);
+
+    for (key, value) in context {
+        buf.extend_from_slice(&(key.len() as u16).to_le_bytes());
+        buf.extend_from_slice(key.as_bytes());
+
+        match value {
+            serde_json::Value::Bool(b) => {
+                buf.push(TAG_BOOL);
+                buf.push(*b as u8);
+            }
+            serde_json::Value::Number(n) if n.is_i64() => {
+                buf.push(TAG_INT);
+                buf.extend_from_slice(&n.as_i64().unwrap_or(0).to_le_bytes());
+            }
+            serde_json::Value::Number(n) => {
+                buf.push(TAG_FLOAT);
+                buf.extend_from_slice(&n.as_f64().unwrap_or(0.0).to_le_bytes());
+            }
+            serde_json::Value::String(s) => {
+                buf.push(TAG_STRING);
+                buf.extend_from_slice(&(s.len() as u32).to_le_bytes());
+                buf.extend_from_slice(s.as_bytes());
+            }
+            other => {
+                let json = other.to_string();
+                buf.push(TAG_JSON);
+                buf.extend_from_slice(&(json.len() as u32).to_le_bytes());
+                buf.extend_from_slice(json.as_bytes());
+            }
+        }
+    }
+
+    Ok(buf)
+}
+
+/// Bounds-checked cursor over the input buffer.
+///
+/// Shared with the batch codec (see `batch_codec`), which frames context
+/// buffers inside its own envelope.
+pub(crate) struct Reader<'a> {
+    pub(crate) buf: &'a [u8],
+    pub(crate) pos: usize,
+}
+
+impl<'a> Reader<'a> {
+    pub(crate) fn take(&mut self, len: usize) -> Result<&'a [u8]> {
+        let end = self.pos.checked_add(len).filter(|&end| end <= self.buf.len());
+        match end {
+            Some(end) => {
+                let slice = &self.buf[self.pos..end];
+                self.pos = end;
+                Ok(slice)
+            }
+            None => Err(OxydeError::BindingError(
+                "Truncated binary buffer".to_string(),
+            )),
+        }
+    }
+
+    pub(crate) fn read_u8(&mut self) -> Result<u8> {
+        Ok(self.take(1)?[0])
+    }
+
+    pub(crate) fn read_u16(&mut self) -> Result<u16> {
+        Ok(u16::from_le_bytes(self.take(2)?.try_into().unwrap()))
+    }
+
+    pub(crate) fn read_u32(&mut self) -> Result<u32> {
+        Ok(u32::from_le_bytes(self.take(4)?.try_into().unwrap()))
+    }
+
+    pub(crate) fn read_u64(&mut self) -> Result<u64> {
+        Ok(u64::from_le_bytes(self.take(8)?.try_into().unwrap()))
+    }
+
+    pub(crate) fn read_i64(&mut self) -> Result<i64> {
+        Ok(i64::from_le_bytes(self.take(8)?.try_into().unwrap()))
+    }
+
+    pub(crate) fn read_f64(&mut self) -> Result<f64> {
+        Ok(f64::from_le_bytes(self.take(8)?.try_into().unwrap()))
+    }
+
+    pub(crate) fn read_str(&mut self, len: usize) -> Result<&'a str> {
+        std::str::from_utf8(self.take(len)?).map_err(|e| {
+            OxydeError::BindingError(format!("Invalid UTF-8 in binary buffer: {}", e))
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_round_trip_typed_fields() {
+        let mut context = AgentContext::new();
+        context.insert("player_distance".to_string(), serde_json::json!(3.5));
+        context.insert("health".to_string(), serde_json::json!(87));
+        context.insert("in_combat".to_string(), serde_json::json!(true));
+        context.insert("zone".to_string(), serde_json::json!("market"));
+
+        let encoded = encode_context(&context).unwrap();
+        let decoded = decode_context(&encoded).unwrap();
+        assert_eq!(decoded, context);
+    }
+
+    #[test]
+    fn test_complex_values_round_trip_through_json_fallback() {
+        let mut context = AgentContext::new();
+        context.insert(
+            "inventory".to_string(),
+            serde_json::json!({"gold": 12, "items": ["sword", "rope"]}),
+        );
+
+        let encoded = encode_context(&context).unwrap();
+        let decoded = decode_context(&encoded).unwrap();
+        assert_eq!(decoded, context);
+    }
+
+    #[test]
+    fn test_malformed_buffers_are_rejected() {
+        assert!(decode_context(&[]).is_err());
+        assert!(decode_context(&[0x00, 0x00, 1, 0]).is_err()); // bad magic
+
+        let mut context = AgentContext::new();
+        context.insert("health".to_string(), serde_json::json!(10));
+        let mut encoded = encode_context(&context).unwrap();
+        encoded.truncate(encoded.len() - 2); // cut into the payload
+        assert!(decode_context(&encoded).is_err());
+    }
+}
@@ -8,6 +8,8 @@ pub use self::unreal::{UnrealBinding, UnrealAgentConfig};
 pub use self::wasm::WasmBinding;
 
 // Modules
+pub mod batch_codec;
+pub mod context_codec;
 pub mod unity;
 pub mod unreal;
 pub mod wasm;
@@ -82,10 +84,15 @@ pub trait EngineBinding {
 /// # Returns
 ///
 /// An agent configuration or an error
+///
+/// Loads go through the process-wide config cache, so spawning many agents
+/// from the same file parses it once.
 pub fn load_agent_config(config_path: &str) -> Result<AgentConfig> {
-    AgentConfig::from_file(config_path).map_err(|e| {
-        OxydeError::BindingError(format!("Failed to load agent config: {}", e))
-    })
+    AgentConfig::load_cached(config_path)
+        .map(|config| (*config).clone())
+        .map_err(|e| {
+            OxydeError::BindingError(format!("Failed to load agent config: {}", e))
+        })
 }
 
 /// Helper function to parse agent configuration from JSON string
@@ -97,10 +104,15 @@ pub fn load_agent_config(config_path: &str) -> Result<AgentConfig> {
 /// # Returns
 ///
 /// An agent configuration or an error
+///
+/// Parses go through the process-wide config cache keyed by content hash,
+/// so repeated spawns of the same archetype skip the JSON parse.
 pub fn parse_agent_config_json(json: &str) -> Result<AgentConfig> {
-    serde_json::from_str(json).map_err(|e| {
-        OxydeError::BindingError(format!("Failed to parse agent config JSON: {}", e))
-    })
+    AgentConfig::parse_cached_json(json)
+        .map(|config| (*config).clone())
+        .map_err(|e| {
+            OxydeError::BindingError(format!("Failed to parse agent config JSON: {}", e))
+        })
 }
 
 /// Helper function to parse context JSON
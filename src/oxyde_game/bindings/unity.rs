@@ -2,8 +2,10 @@
 //!
 //! This module provides bindings for integrating Oxyde with Unity game engine.
 
+use std::collections::hash_map::DefaultHasher;
 use std::collections::HashMap;
-use std::sync::{Arc, Mutex};
+use std::hash::{Hash, Hasher};
+use std::sync::{Arc, Mutex, RwLock};
 use std::ffi::CString;
 
 use serde::{Deserialize, Serialize};
@@ -60,20 +62,45 @@ impl From<&Agent> for UnityAgentState {
     }
 }
 
+/// Number of shards in the agent registry; string lookups only contend
+/// within a shard instead of on one global map
+const REGISTRY_SHARDS: usize = 8;
+
+/// Entry in a registry shard: the agent plus its numeric handle
+type ShardEntry = (u64, Arc<Agent>);
+
 /// Unity binding for Oxyde SDK
 pub struct UnityBinding {
-    /// Registry of created agents
-    agents: Arc<Mutex<HashMap<String, Arc<Agent>>>>,
+    /// Sharded registry of created agents, keyed by ID string
+    shards: Vec<Mutex<HashMap<String, ShardEntry>>>,
+
+    /// Slot table for integer-handle lookups (handle = slot index + 1, so
+    /// 0 can be used as the error value across the FFI)
+    slots: RwLock<Vec<Option<Arc<Agent>>>>,
+
+    /// Slot indices freed by destroyed agents, reused on registration
+    free_slots: Mutex<Vec<usize>>,
 }
 
 impl UnityBinding {
     /// Create a new Unity binding
     pub fn new() -> Self {
         Self {
-            agents: Arc::new(Mutex::new(HashMap::new())),
+            shards: (0..REGISTRY_SHARDS)
+                .map(|_| Mutex::new(HashMap::new()))
+                .collect(),
+            slots: RwLock::new(Vec::new()),
+            free_slots: Mutex::new(Vec::new()),
         }
     }
-    
+
+    /// Get the registry shard for an agent ID string
+    fn shard_for(&self, id: &str) -> &Mutex<HashMap<String, ShardEntry>> {
+        let mut hasher = DefaultHasher::new();
+        id.hash(&mut hasher);
+        &self.shards[(hasher.finish() as usize) % REGISTRY_SHARDS]
+    }
+
     /// Get an agent by ID
     ///
     /// # Arguments
@@ -84,35 +111,152 @@ impl UnityBinding {
     ///
     /// The agent or an error if not found
     pub fn get_agent(&self, id: &str) -> Result<Arc<Agent>> {
-        let agents = self.agents.lock().map_err(|e| {
+        let agents = self.shard_for(id).lock().map_err(|e| {
             OxydeError::BindingError(format!("Failed to lock agents mutex: {}", e))
         })?;
         agents.get(id)
-            .cloned()
+            .map(|(_, agent)| agent.clone())
             .ok_or_else(|| {
                 OxydeError::BindingError(format!("Agent with ID {} not found", id))
             })
     }
-    
+
+    /// Get an agent by its numeric handle
+    ///
+    /// This is the fast path for per-frame calls: a read lock and an array
+    /// index instead of a string hash lookup.
+    ///
+    /// # Arguments
+    ///
+    /// * `handle` - Handle returned when the agent was registered
+    ///
+    /// # Returns
+    ///
+    /// The agent or an error if the handle is invalid
+    pub fn get_agent_by_handle(&self, handle: u64) -> Result<Arc<Agent>> {
+        let slots = self.slots.read().map_err(|e| {
+            OxydeError::BindingError(format!("Failed to lock agent slots: {}", e))
+        })?;
+        handle
+            .checked_sub(1)
+            .and_then(|index| slots.get(index as usize))
+            .and_then(|slot| slot.clone())
+            .ok_or_else(|| {
+                OxydeError::BindingError(format!("Agent with handle {} not found", handle))
+            })
+    }
+
+    /// Look up the numeric handle for an agent ID string
+    ///
+    /// # Arguments
+    ///
+    /// * `id` - Agent ID
+    ///
+    /// # Returns
+    ///
+    /// The agent's handle, or `None` if the ID is unknown
+    pub fn handle_for(&self, id: &str) -> Option<u64> {
+        let agents = self
+            .shard_for(id)
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        agents.get(id).map(|(handle, _)| *handle)
+    }
+
     /// Register a new agent
     ///
     /// # Arguments
     ///
     /// * `id` - Agent unique identifier
     /// * `agent` - Agent to register
-    pub fn register_agent(&self, id: Uuid, agent: Arc<Agent>) {
-        match self.agents.lock() {
+    ///
+    /// # Returns
+    ///
+    /// Numeric handle for the registered agent
+    pub fn register_agent(&self, id: Uuid, agent: Arc<Agent>) -> u64 {
+        // Claim a slot first so the handle can be stored alongside the
+        // string entry
+        let index = {
+            let mut free_slots = self
+                .free_slots
+                .lock()
+                .unwrap_or_else(|poisoned| poisoned.into_inner());
+            let mut slots = self
+                .slots
+                .write()
+                .unwrap_or_else(|poisoned| poisoned.into_inner());
+            match free_slots.pop() {
+                Some(index) => {
+                    slots[index] = Some(agent.clone());
+                    index
+                }
+                None => {
+                    slots.push(Some(agent.clone()));
+                    slots.len() - 1
+                }
+            }
+        };
+        let handle = (index + 1) as u64;
+
+        let id_str = id.to_string();
+        match self.shard_for(&id_str).lock() {
             Ok(mut agents) => {
-                agents.insert(id.to_string(), agent);
+                agents.insert(id_str, (handle, agent));
             }
             Err(poisoned) => {
                 log::warn!("Agents mutex was poisoned, recovering and continuing");
                 let mut agents = poisoned.into_inner();
-                agents.insert(id.to_string(), agent);
+                agents.insert(id_str, (handle, agent));
             }
         }
+
+        handle
     }
-    
+
+    /// Remove an agent from the registry by handle
+    ///
+    /// # Arguments
+    ///
+    /// * `handle` - Handle returned when the agent was registered
+    ///
+    /// # Returns
+    ///
+    /// True if the handle referred to a registered agent
+    pub fn unregister_agent(&self, handle: u64) -> bool {
+        let index = match handle.checked_sub(1) {
+            Some(index) => index as usize,
+            None => return false,
+        };
+
+        let agent = {
+            let mut slots = self
+                .slots
+                .write()
+                .unwrap_or_else(|poisoned| poisoned.into_inner());
+            match slots.get_mut(index).and_then(|slot| slot.take()) {
+                Some(agent) => agent,
+                None => return false,
+            }
+        };
+
+        {
+            let mut free_slots = self
+                .free_slots
+                .lock()
+                .unwrap_or_else(|poisoned| poisoned.into_inner());
+            free_slots.push(index);
+        }
+
+        let id_str = agent.id().to_string();
+        let mut agents = self
+            .shard_for(&id_str)
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        agents.remove(&id_str);
+
+        true
+    }
+
     /// Convert Unity context to Oxyde context
     ///
     /// # Arguments
@@ -191,20 +335,12 @@ impl EngineBinding for UnityBinding {
         let context = self.parse_unity_context(context_json)?;
 
         // Get a new copy of the agent from the registry
-        let agent_id = agent.id();
-        let agents = self.agents.lock().map_err(|e| {
-            OxydeError::BindingError(format!("Failed to lock agents mutex: {}", e))
-        })?;
-        if let Some(stored_agent) = agents.get(&agent_id.to_string()) {
-            // Use a cloned reference of the stored agent
-            let agent_ref = stored_agent.clone();
-            drop(agents); // Release the lock
-
+        if let Ok(agent_ref) = self.get_agent(&agent.id().to_string()) {
             RUNTIME.spawn(async move {
                 agent_ref.update_context(context).await;
             });
         }
-        
+
         Ok(())
     }
     
@@ -226,7 +362,18 @@ pub mod ffi {
     use super::*;
     use std::ffi::CString;
     use std::os::raw::c_char;
-    
+
+    /// C# callback invoked with each chunk of a streamed response
+    ///
+    /// Both pointers are only valid for the duration of the callback, and
+    /// chunks arrive on a worker thread rather than Unity's main thread.
+    pub type OxydeChunkCallback = extern "C" fn(agent_id: *const c_char, chunk: *const c_char);
+
+    lazy_static::lazy_static! {
+        /// Optional callback invoked with each chunk of a streamed response
+        static ref CHUNK_CALLBACK: Mutex<Option<OxydeChunkCallback>> = Mutex::new(None);
+    }
+
     static mut BINDING: Option<UnityBinding> = None;
     
     fn get_binding() -> &'static UnityBinding {
@@ -246,6 +393,40 @@ pub mod ffi {
             .into_raw()
     }
 
+    /// Register a callback invoked with each chunk of streamed responses
+    ///
+    /// Pass a null function pointer to clear the callback. Set this BEFORE
+    /// creating agents: agents created while a chunk callback is registered
+    /// stream their generated responses through it; agents created without
+    /// one keep the buffered (non-streaming) inference path.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_set_chunk_callback(callback: Option<OxydeChunkCallback>) {
+        let mut cb = CHUNK_CALLBACK.lock().unwrap_or_else(|p| p.into_inner());
+        *cb = callback;
+    }
+
+    /// Wire a newly created agent to the registered chunk callback, if any
+    fn register_chunk_forwarder(agent: &Agent) {
+        let registered = CHUNK_CALLBACK
+            .lock()
+            .unwrap_or_else(|p| p.into_inner())
+            .is_some();
+        if !registered {
+            return;
+        }
+
+        agent.on_event(crate::agent::AgentEvent::ResponseChunk, |agent, chunk| {
+            let callback = *CHUNK_CALLBACK.lock().unwrap_or_else(|p| p.into_inner());
+            if let Some(callback) = callback {
+                let id = CString::new(agent.id().to_string());
+                let chunk = CString::new(chunk);
+                if let (Ok(id), Ok(chunk)) = (id, chunk) {
+                    callback(id.as_ptr(), chunk.as_ptr());
+                }
+            }
+        });
+    }
+
     /// Initialize the Oxyde SDK for Unity
     #[no_mangle]
     pub extern "C" fn oxyde_unity_init() -> bool {
@@ -263,6 +444,7 @@ pub mod ffi {
         
         match binding.create_agent(&config_path_str) {
             Ok(agent) => {
+                register_chunk_forwarder(&agent);
                 let agent_id = agent.id().to_string();
                 string_to_ptr(agent_id)
             },
@@ -278,6 +460,7 @@ pub mod ffi {
         
         match binding.create_agent_from_json(&json_config_str) {
             Ok(agent) => {
+                register_chunk_forwarder(&agent);
                 let agent_id = agent.id().to_string();
                 string_to_ptr(agent_id)
             },
@@ -285,6 +468,62 @@ pub mod ffi {
         }
     }
     
+    /// Create a new agent from a configuration file, returning its handle
+    ///
+    /// Handle-based variant of `oxyde_unity_create_agent`: the returned
+    /// `u64` is a slot index into the registry, so per-frame calls that use
+    /// it skip the string hash lookup entirely. Returns 0 on failure.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_create_agent_handle(config_path: FfiStr) -> u64 {
+        let binding = get_binding();
+        let config_path_str = config_path.into_string();
+
+        match binding.create_agent(&config_path_str) {
+            Ok(agent) => {
+                register_chunk_forwarder(&agent);
+                binding.handle_for(&agent.id().to_string()).unwrap_or(0)
+            }
+            Err(_) => 0,
+        }
+    }
+
+    /// Create a new agent from a configuration JSON string, returning its handle
+    ///
+    /// Returns 0 on failure.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_create_agent_handle_from_json(json_config: FfiStr) -> u64 {
+        let binding = get_binding();
+        let json_config_str = json_config.into_string();
+
+        match binding.create_agent_from_json(&json_config_str) {
+            Ok(agent) => {
+                register_chunk_forwarder(&agent);
+                binding.handle_for(&agent.id().to_string()).unwrap_or(0)
+            }
+            Err(_) => 0,
+        }
+    }
+
+    /// Look up the numeric handle for an agent ID string
+    ///
+    /// Lets callers that created agents through the string API migrate to
+    /// handle-based calls. Returns 0 if the agent is unknown.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_get_agent_handle(agent_id: FfiStr) -> u64 {
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+        binding.handle_for(&agent_id_str).unwrap_or(0)
+    }
+
+    /// Remove an agent from the registry by handle
+    ///
+    /// Frees the agent's slot for reuse; the string ID also stops
+    /// resolving. Returns false if the handle was invalid.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_destroy_agent(handle: u64) -> bool {
+        get_binding().unregister_agent(handle)
+    }
+
     /// Update an agent with new context data
     #[no_mangle]
     pub extern "C" fn oxyde_unity_update_agent(agent_id: FfiStr, context_json: FfiStr) -> bool {
@@ -318,6 +557,106 @@ pub mod ffi {
         }
     }
     
+    /// Update an agent with new context data by handle
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_update_agent_by_handle(handle: u64, context_json: FfiStr) -> bool {
+        let binding = get_binding();
+        let context_json_str = context_json.into_string();
+
+        match binding.get_agent_by_handle(handle) {
+            Ok(agent) => match binding.parse_unity_context(&context_json_str) {
+                Ok(context) => {
+                    RUNTIME.spawn(async move {
+                        agent.update_context(context).await;
+                    });
+                    true
+                }
+                Err(_) => false,
+            },
+            Err(_) => false,
+        }
+    }
+
+    /// Update an agent's context from a binary context buffer
+    ///
+    /// Decodes the compact typed format described in `context_codec`,
+    /// avoiding the per-frame JSON parse of `oxyde_unity_update_agent`.
+    /// Returns false for a malformed buffer or unknown agent.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_update_agent_binary(
+        agent_id: FfiStr,
+        buf: *const u8,
+        len: u32,
+    ) -> bool {
+        if buf.is_null() {
+            return false;
+        }
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+
+        let bytes = unsafe { std::slice::from_raw_parts(buf, len as usize) };
+        let context = match crate::oxyde_game::bindings::context_codec::decode_context(bytes) {
+            Ok(context) => context,
+            Err(_) => return false,
+        };
+
+        match binding.get_agent(&agent_id_str) {
+            Ok(agent) => {
+                RUNTIME.spawn(async move {
+                    agent.update_context(context).await;
+                });
+                true
+            }
+            Err(_) => false,
+        }
+    }
+
+    /// Update an agent's context from a binary context buffer, by handle
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_update_agent_binary_by_handle(
+        handle: u64,
+        buf: *const u8,
+        len: u32,
+    ) -> bool {
+        if buf.is_null() {
+            return false;
+        }
+        let binding = get_binding();
+
+        let bytes = unsafe { std::slice::from_raw_parts(buf, len as usize) };
+        let context = match crate::oxyde_game::bindings::context_codec::decode_context(bytes) {
+            Ok(context) => context,
+            Err(_) => return false,
+        };
+
+        match binding.get_agent_by_handle(handle) {
+            Ok(agent) => {
+                RUNTIME.spawn(async move {
+                    agent.update_context(context).await;
+                });
+                true
+            }
+            Err(_) => false,
+        }
+    }
+
+    /// Process input for an agent by handle
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_process_input_by_handle(handle: u64, input: FfiStr) -> *mut c_char {
+        let binding = get_binding();
+        let input_str = input.into_string();
+
+        match binding.get_agent_by_handle(handle) {
+            Ok(agent) => {
+                match binding.process_input(&agent, &input_str) {
+                    Ok(response) => string_to_ptr(response),
+                    Err(e) => string_to_ptr(format!("Error processing input: {}", e)),
+                }
+            },
+            Err(_) => string_to_ptr("Agent not found".to_string()),
+        }
+    }
+
     /// Get agent state
     #[no_mangle]
     pub extern "C" fn oxyde_unity_get_agent_state(agent_id: FfiStr) -> *mut c_char {
@@ -335,6 +674,22 @@ pub mod ffi {
         }
     }
     
+    /// Get a JSON snapshot of the SDK metrics registry
+    ///
+    /// Covers latency histograms and counters for the SDK hot paths
+    /// (process_input, memory retrieval, TTS). The returned string must be
+    /// freed with `oxyde_unity_free_string`.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_get_metrics() -> *mut c_char {
+        string_to_ptr(crate::metrics::global().snapshot_json())
+    }
+
+    /// Enable or disable SDK metric recording
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_set_metrics_enabled(enabled: bool) {
+        crate::metrics::set_enabled(enabled);
+    }
+
     /// Get agent emotion vector
     #[no_mangle]
     pub extern "C" fn oxyde_unity_get_emotion_vector(agent_id: FfiStr) -> *mut c_char {
@@ -419,6 +774,63 @@ pub mod ffi {
         }
     }
 
+    /// Get agent emotion vector as raw floats by handle
+    ///
+    /// Handle-based variant of `oxyde_unity_get_emotion_vector_raw` for
+    /// per-frame polling across many agents.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_get_emotion_vector_raw_by_handle(
+        handle: u64,
+        out_joy: *mut f32,
+        out_trust: *mut f32,
+        out_fear: *mut f32,
+        out_surprise: *mut f32,
+        out_sadness: *mut f32,
+        out_disgust: *mut f32,
+        out_anger: *mut f32,
+        out_anticipation: *mut f32
+    ) -> bool {
+        let binding = get_binding();
+
+        match binding.get_agent_by_handle(handle) {
+            Ok(agent) => {
+                match binding.get_agent_emotion_vector(&agent) {
+                    Ok(emotion_vector) => {
+                        unsafe {
+                            if !out_joy.is_null() {
+                                *out_joy = emotion_vector[0];
+                            }
+                            if !out_trust.is_null() {
+                                *out_trust = emotion_vector[1];
+                            }
+                            if !out_fear.is_null() {
+                                *out_fear = emotion_vector[2];
+                            }
+                            if !out_surprise.is_null() {
+                                *out_surprise = emotion_vector[3];
+                            }
+                            if !out_sadness.is_null() {
+                                *out_sadness = emotion_vector[4];
+                            }
+                            if !out_disgust.is_null() {
+                                *out_disgust = emotion_vector[5];
+                            }
+                            if !out_anger.is_null() {
+                                *out_anger = emotion_vector[6];
+                            }
+                            if !out_anticipation.is_null() {
+                                *out_anticipation = emotion_vector[7];
+                            }
+                        }
+                        true
+                    },
+                    Err(_) => false,
+                }
+            },
+            Err(_) => false,
+        }
+    }
+
     // ==================== Memory System FFI ====================
 
     /// Add a memory to an agent's memory system
@@ -609,6 +1021,45 @@ pub mod ffi {
         }
     }
 
+    /// Save an agent's memories to a binary snapshot file
+    ///
+    /// Returns the number of memories written, or 0 on failure.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_save_memory_snapshot(agent_id: FfiStr, path: FfiStr) -> u32 {
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+        let path_str = path.into_string();
+
+        match binding.get_agent(&agent_id_str) {
+            Ok(agent) => {
+                RUNTIME.block_on(async {
+                    agent.save_memory_snapshot(&path_str).await.unwrap_or(0) as u32
+                })
+            },
+            Err(_) => 0,
+        }
+    }
+
+    /// Load an agent's memories from a binary snapshot file
+    ///
+    /// Replaces the agent's current memories. Returns the number of memories
+    /// loaded, or 0 on failure.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unity_load_memory_snapshot(agent_id: FfiStr, path: FfiStr) -> u32 {
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+        let path_str = path.into_string();
+
+        match binding.get_agent(&agent_id_str) {
+            Ok(agent) => {
+                RUNTIME.block_on(async {
+                    agent.load_memory_snapshot(&path_str).await.unwrap_or(0) as u32
+                })
+            },
+            Err(_) => 0,
+        }
+    }
+
     // ==================== End Memory System FFI ====================
 
     /// Free a string allocated by the Oxyde SDK
@@ -625,12 +1076,68 @@ pub mod ffi {
 #[cfg(test)]
 mod tests {
     use super::*;
-    
+    use crate::config::{AgentConfig, AgentPersonality, InferenceConfig, MemoryConfig};
+
+    fn test_config(name: &str) -> AgentConfig {
+        AgentConfig {
+            agent: AgentPersonality {
+                name: name.to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig::default(),
+            behavior: HashMap::new(),
+            moderation: crate::config::ModerationConfig::default(),
+            tts: None,
+        }
+    }
+
     #[test]
     fn test_unity_binding_creation() {
         let binding = UnityBinding::new();
         assert_eq!(binding.name(), "unity");
     }
+
+    #[test]
+    fn test_handle_registry_lookup() {
+        let binding = UnityBinding::new();
+        let agent = Arc::new(Agent::new(test_config("Handle Agent")));
+        let id = agent.id();
+
+        let handle = binding.register_agent(id, agent.clone());
+        assert_ne!(handle, 0);
+
+        // Both lookup paths resolve to the same agent
+        assert_eq!(binding.get_agent_by_handle(handle).unwrap().id(), id);
+        assert_eq!(binding.get_agent(&id.to_string()).unwrap().id(), id);
+        assert_eq!(binding.handle_for(&id.to_string()), Some(handle));
+
+        // Invalid handles fail cleanly
+        assert!(binding.get_agent_by_handle(0).is_err());
+        assert!(binding.get_agent_by_handle(handle + 100).is_err());
+    }
+
+    #[test]
+    fn test_handle_registry_unregister_and_slot_reuse() {
+        let binding = UnityBinding::new();
+        let first = Arc::new(Agent::new(test_config("First")));
+        let first_id = first.id();
+
+        let handle = binding.register_agent(first_id, first);
+        assert!(binding.unregister_agent(handle));
+
+        // Both lookup paths stop resolving
+        assert!(binding.get_agent_by_handle(handle).is_err());
+        assert!(binding.get_agent(&first_id.to_string()).is_err());
+        assert!(!binding.unregister_agent(handle));
+
+        // The freed slot is reused for the next registration
+        let second = Arc::new(Agent::new(test_config("Second")));
+        let second_handle = binding.register_agent(second.id(), second);
+        assert_eq!(second_handle, handle);
+    }
     
     #[test]
     fn test_parse_unity_context() {
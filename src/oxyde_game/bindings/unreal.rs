@@ -182,9 +182,109 @@ impl EngineBinding for UnrealBinding {
 #[cfg(feature = "unreal")]
 pub mod ffi {
     use super::*;
+    use std::cell::RefCell;
     use std::ffi::CString;
     use std::os::raw::c_char;
-    
+    use std::sync::atomic::{AtomicU64, Ordering};
+
+    /// The string was copied into the caller's buffer
+    pub const OXYDE_BUFFER_OK: i32 = 0;
+    /// The caller's buffer is too small; the required size (including the
+    /// NUL terminator) has been written to `buf_len`
+    pub const OXYDE_BUFFER_TOO_SMALL: i32 = 1;
+    /// The call failed (agent not found, inference error, null arguments)
+    pub const OXYDE_BUFFER_ERROR: i32 = -1;
+    /// The async request is still pending or the handle is unknown
+    pub const OXYDE_BUFFER_PENDING: i32 = -2;
+
+    thread_local! {
+        /// Per-thread scratch string reused when formatting responses, so
+        /// `_into`-style calls don't allocate on every invocation
+        static SCRATCH: RefCell<String> = RefCell::new(String::new());
+    }
+
+    lazy_static::lazy_static! {
+        static ref RUNTIME: tokio::runtime::Runtime = tokio::runtime::Builder::new_multi_thread()
+            .enable_all()
+            .build()
+            .expect("Failed to create global Tokio runtime");
+
+        /// Completed (or failed) async responses waiting to be polled
+        static ref ASYNC_RESPONSES: Mutex<HashMap<u64, AsyncResponseState>> =
+            Mutex::new(HashMap::new());
+
+        /// Optional completion callback invoked when an async request finishes
+        static ref RESPONSE_CALLBACK: Mutex<Option<OxydeResponseCallback>> = Mutex::new(None);
+
+        /// Optional callback invoked with each chunk of a streamed response
+        static ref CHUNK_CALLBACK: Mutex<Option<OxydeChunkCallback>> = Mutex::new(None);
+
+        /// Batch response stashed when the caller's output buffer was too
+        /// small, served to the retry instead of re-executing the batch
+        static ref STASHED_BATCH: Mutex<Option<StashedBatchResponse>> = Mutex::new(None);
+
+        /// Synchronous response stashed when the caller's buffer was too
+        /// small, served to the retry instead of re-processing the input
+        static ref STASHED_INPUT_RESPONSE: Mutex<Option<StashedInputResponse>> =
+            Mutex::new(None);
+    }
+
+    /// A generated response held back for a grow-and-retry caller
+    ///
+    /// `Agent::process_input` stores memories, updates emotions and fires
+    /// events, so a too-small caller buffer must not make the retry run it
+    /// again; the retry is matched by agent and input and served a pure copy.
+    struct StashedInputResponse {
+        /// Agent the response belongs to
+        agent_id: String,
+        /// Input that produced the response
+        input: String,
+        /// The response waiting to be copied out
+        response: String,
+    }
+
+    /// Encoded batch response held back for a grow-and-retry caller
+    ///
+    /// `oxyde_unreal_tick_batch` applies context updates and submits inputs
+    /// before it can size its output, so a too-small output buffer must not
+    /// make the caller replay the batch: that would run every input through
+    /// inference a second time and leak the first submission's handles. The
+    /// stash keeps the already-encoded response keyed by the request bytes
+    /// that produced it; the retry is served a pure copy.
+    struct StashedBatchResponse {
+        /// The request bytes this stash answers; a different request drops it
+        request: Vec<u8>,
+        /// The encoded response waiting to be copied out
+        encoded: Vec<u8>,
+        /// Handles removed from `ASYNC_RESPONSES` once the copy succeeds
+        completed: Vec<u64>,
+    }
+
+    /// Next handle for async requests (0 is reserved as the error value)
+    static NEXT_REQUEST_HANDLE: AtomicU64 = AtomicU64::new(1);
+
+    /// State of an in-flight or completed async request
+    enum AsyncResponseState {
+        /// Inference is still running
+        Pending,
+        /// Response text is ready to be taken
+        Ready(String),
+        /// Processing failed with an error message
+        Failed(String),
+    }
+
+    /// C callback invoked when an async request completes
+    ///
+    /// The response pointer is only valid for the duration of the callback;
+    /// callers that need to keep the text must copy it.
+    pub type OxydeResponseCallback = extern "C" fn(handle: u64, response: *const c_char, success: bool);
+
+    /// C callback invoked with each chunk of a streamed response
+    ///
+    /// Both pointers are only valid for the duration of the callback. Like
+    /// the response callback, chunks arrive on a worker thread.
+    pub type OxydeChunkCallback = extern "C" fn(agent_id: *const c_char, chunk: *const c_char);
+
     static mut BINDING: Option<UnrealBinding> = None;
     
     fn get_binding() -> &'static UnrealBinding {
@@ -204,6 +304,91 @@ pub mod ffi {
             .into_raw()
     }
 
+    /// Copy a string into a caller-provided buffer as NUL-terminated UTF-8
+    ///
+    /// `buf_len` is in/out: the caller passes the buffer capacity in bytes
+    /// and receives the number of bytes written (excluding the NUL), or the
+    /// required capacity when the buffer is too small. Unlike the
+    /// pointer-returning APIs, nothing is allocated and nothing needs to be
+    /// freed with `oxyde_unreal_free_string`.
+    fn write_to_buffer(text: &str, buf: *mut c_char, buf_len: *mut u32) -> i32 {
+        if buf.is_null() || buf_len.is_null() {
+            return OXYDE_BUFFER_ERROR;
+        }
+
+        let bytes = text.as_bytes();
+        let needed = bytes.len() + 1;
+
+        unsafe {
+            if (*buf_len as usize) < needed {
+                *buf_len = needed as u32;
+                return OXYDE_BUFFER_TOO_SMALL;
+            }
+
+            std::ptr::copy_nonoverlapping(bytes.as_ptr(), buf as *mut u8, bytes.len());
+            *buf.add(bytes.len()) = 0;
+            *buf_len = bytes.len() as u32;
+        }
+
+        OXYDE_BUFFER_OK
+    }
+
+    /// Copy raw bytes into a caller-provided buffer
+    ///
+    /// Binary variant of `write_to_buffer`: no NUL terminator is appended.
+    /// `buf_len` is in/out with the same capacity-or-required semantics.
+    fn write_bytes_to_buffer(bytes: &[u8], buf: *mut u8, buf_len: *mut u32) -> i32 {
+        if buf.is_null() || buf_len.is_null() {
+            return OXYDE_BUFFER_ERROR;
+        }
+
+        unsafe {
+            if (*buf_len as usize) < bytes.len() {
+                *buf_len = bytes.len() as u32;
+                return OXYDE_BUFFER_TOO_SMALL;
+            }
+
+            std::ptr::copy_nonoverlapping(bytes.as_ptr(), buf, bytes.len());
+            *buf_len = bytes.len() as u32;
+        }
+
+        OXYDE_BUFFER_OK
+    }
+
+    /// Register a callback invoked with each chunk of streamed responses
+    ///
+    /// Pass a null function pointer to clear the callback. Set this BEFORE
+    /// creating agents: agents created while a chunk callback is registered
+    /// stream their generated responses through it; agents created without
+    /// one keep the buffered (non-streaming) inference path.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_set_chunk_callback(callback: Option<OxydeChunkCallback>) {
+        let mut cb = CHUNK_CALLBACK.lock().unwrap_or_else(|p| p.into_inner());
+        *cb = callback;
+    }
+
+    /// Wire a newly created agent to the registered chunk callback, if any
+    fn register_chunk_forwarder(agent: &Agent) {
+        let registered = CHUNK_CALLBACK
+            .lock()
+            .unwrap_or_else(|p| p.into_inner())
+            .is_some();
+        if !registered {
+            return;
+        }
+
+        agent.on_event(crate::agent::AgentEvent::ResponseChunk, |agent, chunk| {
+            let callback = *CHUNK_CALLBACK.lock().unwrap_or_else(|p| p.into_inner());
+            if let Some(callback) = callback {
+                let id = CString::new(agent.id().to_string());
+                let chunk = CString::new(chunk);
+                if let (Ok(id), Ok(chunk)) = (id, chunk) {
+                    callback(id.as_ptr(), chunk.as_ptr());
+                }
+            }
+        });
+    }
+
     /// Initialize the Oxyde SDK for Unreal Engine
     #[no_mangle]
     pub extern "C" fn oxyde_unreal_init() -> bool {
@@ -219,6 +404,7 @@ pub mod ffi {
         
         match binding.create_agent(&config_path_str) {
             Ok(agent) => {
+                register_chunk_forwarder(&agent);
                 let agent_id = agent.id().to_string();
                 string_to_ptr(agent_id)
             },
@@ -231,9 +417,10 @@ pub mod ffi {
     pub extern "C" fn oxyde_unreal_create_agent_from_json(json_config: FfiStr) -> *mut c_char {
         let binding = get_binding();
         let json_config_str = json_config.into_string();
-        
+
         match binding.create_agent_from_json(&json_config_str) {
             Ok(agent) => {
+                register_chunk_forwarder(&agent);
                 let agent_id = agent.id().to_string();
                 string_to_ptr(agent_id)
             },
@@ -256,6 +443,40 @@ pub mod ffi {
         }
     }
     
+    /// Update an agent's context from a binary context buffer
+    ///
+    /// Decodes the compact typed format described in `context_codec`,
+    /// avoiding the per-frame JSON parse of `oxyde_unreal_update_agent`.
+    /// Returns false for a malformed buffer or unknown agent.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_update_agent_binary(
+        agent_id: FfiStr,
+        buf: *const u8,
+        len: u32,
+    ) -> bool {
+        if buf.is_null() {
+            return false;
+        }
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+
+        let bytes = unsafe { std::slice::from_raw_parts(buf, len as usize) };
+        let context = match crate::oxyde_game::bindings::context_codec::decode_context(bytes) {
+            Ok(context) => context,
+            Err(_) => return false,
+        };
+
+        match binding.get_agent(&agent_id_str) {
+            Ok(agent) => {
+                RUNTIME.spawn(async move {
+                    agent.update_context(context).await;
+                });
+                true
+            }
+            Err(_) => false,
+        }
+    }
+
     /// Process input for an agent
     #[no_mangle]
     pub extern "C" fn oxyde_unreal_process_input(agent_id: FfiStr, input: FfiStr) -> *mut c_char {
@@ -280,6 +501,359 @@ pub mod ffi {
         }
     }
 
+    /// Process input for an agent into a caller-provided buffer
+    ///
+    /// Buffer-reuse variant of `oxyde_unreal_process_input`: the response is
+    /// copied into `buf` instead of being returned as a freshly allocated
+    /// string, so callers that keep a reusable buffer avoid an allocation
+    /// and a free per call. `buf_len` is in/out (capacity in, bytes written
+    /// or required capacity out). Returns `OXYDE_BUFFER_OK`,
+    /// `OXYDE_BUFFER_TOO_SMALL`, or `OXYDE_BUFFER_ERROR`.
+    ///
+    /// When the buffer is too small the generated response is kept on the
+    /// native side; retrying with the same agent and input serves it as a
+    /// pure copy, so the input is processed — memories stored, emotions
+    /// updated, events fired — exactly once.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_process_input_into(
+        agent_id: FfiStr,
+        input: FfiStr,
+        buf: *mut c_char,
+        buf_len: *mut u32,
+    ) -> i32 {
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+        let input_str = input.into_string();
+
+        // A previous call already processed this input and stashed its
+        // response because the buffer was too small; serve the stash
+        // rather than running process_input (and its side effects) again
+        {
+            let mut stash = STASHED_INPUT_RESPONSE
+                .lock()
+                .unwrap_or_else(|p| p.into_inner());
+            if let Some(stashed) = stash.take() {
+                if stashed.agent_id == agent_id_str && stashed.input == input_str {
+                    let status = write_to_buffer(&stashed.response, buf, buf_len);
+                    if status != OXYDE_BUFFER_OK {
+                        // Still too small (or bad pointers); keep the stash
+                        // for the next retry
+                        *stash = Some(stashed);
+                    }
+                    return status;
+                }
+                // A different request arrived instead of a retry; the
+                // stale stash is dropped
+            }
+        }
+
+        let agent = match binding.get_agent(&agent_id_str) {
+            Ok(agent) => agent,
+            Err(_) => return OXYDE_BUFFER_ERROR,
+        };
+
+        match RUNTIME.block_on(async { agent.process_input(&input_str).await }) {
+            Ok(response) => {
+                let status = write_to_buffer(&response, buf, buf_len);
+                if status == OXYDE_BUFFER_TOO_SMALL {
+                    // The input has already been processed; hold the
+                    // response for the grow-and-retry call
+                    let mut stash = STASHED_INPUT_RESPONSE
+                        .lock()
+                        .unwrap_or_else(|p| p.into_inner());
+                    *stash = Some(StashedInputResponse {
+                        agent_id: agent_id_str,
+                        input: input_str,
+                        response,
+                    });
+                }
+                status
+            }
+            Err(_) => OXYDE_BUFFER_ERROR,
+        }
+    }
+
+    /// Register a callback invoked whenever an async request completes
+    ///
+    /// Pass a null function pointer to clear the callback. The callback is
+    /// invoked from a worker thread, not the game thread; Unreal callers
+    /// should marshal back to the game thread before touching engine state.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_set_response_callback(callback: Option<OxydeResponseCallback>) {
+        let mut cb = RESPONSE_CALLBACK.lock().unwrap_or_else(|p| p.into_inner());
+        *cb = callback;
+    }
+
+    /// Process input for an agent without blocking the calling thread
+    ///
+    /// Returns a request handle immediately (0 on failure). The response is
+    /// delivered via the callback registered with
+    /// `oxyde_unreal_set_response_callback`, or retrieved by polling
+    /// `oxyde_unreal_poll_response` with the returned handle.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_process_input_async(agent_id: FfiStr, input: FfiStr) -> u64 {
+        submit_async_input(&agent_id.into_string(), input.into_string())
+    }
+
+    /// Queue input for an agent, returning its async handle
+    ///
+    /// Shared between the per-agent async entry point and the batched tick.
+    /// Returns 0 when the agent is unknown.
+    fn submit_async_input(agent_id: &str, input_str: String) -> u64 {
+        let binding = get_binding();
+
+        let agent = match binding.get_agent(agent_id) {
+            Ok(agent) => agent,
+            Err(_) => return 0,
+        };
+
+        let handle = NEXT_REQUEST_HANDLE.fetch_add(1, Ordering::SeqCst);
+        {
+            let mut responses = ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+            responses.insert(handle, AsyncResponseState::Pending);
+        }
+
+        RUNTIME.spawn(async move {
+            let result = agent.process_input(&input_str).await;
+
+            let (state, text, success) = match result {
+                Ok(response) => (AsyncResponseState::Ready(response.clone()), response, true),
+                Err(e) => {
+                    let msg = format!("Error processing input: {}", e);
+                    (AsyncResponseState::Failed(msg.clone()), msg, false)
+                }
+            };
+
+            {
+                let mut responses = ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+                responses.insert(handle, state);
+            }
+
+            // Invoke the completion callback if one is registered. The
+            // response entry stays in the map until polled or freed so
+            // callback-less callers can still retrieve it.
+            let callback = *RESPONSE_CALLBACK.lock().unwrap_or_else(|p| p.into_inner());
+            if let Some(callback) = callback {
+                if let Ok(c_text) = CString::new(text) {
+                    callback(handle, c_text.as_ptr(), success);
+                }
+            }
+        });
+
+        handle
+    }
+
+    /// Poll for the response to an async request
+    ///
+    /// Returns null while the request is still pending or if the handle is
+    /// unknown. Once a response (or error message, matching the sync API's
+    /// behavior) is returned, the handle is consumed and subsequent polls
+    /// return null. The returned string must be freed with
+    /// `oxyde_unreal_free_string`.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_poll_response(handle: u64) -> *mut c_char {
+        let mut responses = ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+
+        match responses.get(&handle) {
+            Some(AsyncResponseState::Pending) => std::ptr::null_mut(),
+            Some(_) => {
+                let state = responses.remove(&handle).expect("entry checked above");
+                match state {
+                    AsyncResponseState::Ready(text) | AsyncResponseState::Failed(text) => {
+                        string_to_ptr(text)
+                    }
+                    AsyncResponseState::Pending => unreachable!(),
+                }
+            }
+            None => std::ptr::null_mut(),
+        }
+    }
+
+    /// Poll for an async response into a caller-provided buffer
+    ///
+    /// Buffer-reuse variant of `oxyde_unreal_poll_response`. Returns
+    /// `OXYDE_BUFFER_PENDING` while the request is in flight or the handle
+    /// is unknown. When the response is ready but the buffer is too small,
+    /// the required capacity is written to `buf_len` and the handle is NOT
+    /// consumed, so the caller can grow the buffer and poll again. On a
+    /// successful copy the handle is consumed; failed requests copy their
+    /// error message and return `OXYDE_BUFFER_ERROR`.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_poll_response_into(
+        handle: u64,
+        buf: *mut c_char,
+        buf_len: *mut u32,
+    ) -> i32 {
+        let mut responses = ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+
+        let (text, failed) = match responses.get(&handle) {
+            Some(AsyncResponseState::Ready(text)) => (text, false),
+            Some(AsyncResponseState::Failed(text)) => (text, true),
+            Some(AsyncResponseState::Pending) | None => return OXYDE_BUFFER_PENDING,
+        };
+
+        let status = write_to_buffer(text, buf, buf_len);
+        if status == OXYDE_BUFFER_OK {
+            responses.remove(&handle);
+            if failed {
+                return OXYDE_BUFFER_ERROR;
+            }
+        }
+        status
+    }
+
+    /// Check whether an async request has completed
+    ///
+    /// Returns true once a response is available for `oxyde_unreal_poll_response`.
+    /// Unknown or already-consumed handles return false.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_response_ready(handle: u64) -> bool {
+        let responses = ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+        matches!(
+            responses.get(&handle),
+            Some(AsyncResponseState::Ready(_)) | Some(AsyncResponseState::Failed(_))
+        )
+    }
+
+    /// Cancel interest in an async request, dropping its response when done
+    ///
+    /// The inference task itself is not interrupted; this only releases the
+    /// stored response so abandoned handles don't accumulate.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_discard_response(handle: u64) {
+        let mut responses = ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+        responses.remove(&handle);
+    }
+
+    /// Execute one batched tick of engine traffic
+    ///
+    /// The request buffer carries a whole frame's agent traffic — dirty
+    /// context updates, queued inputs and outstanding response handles —
+    /// in the format described in `batch_codec`, so a crowd of agents
+    /// costs one FFI crossing per frame instead of one per agent. The
+    /// response buffer receives one handle per submitted input (0 for
+    /// unknown agents) followed by the completed responses among the
+    /// polled handles; handles that are still pending are simply absent
+    /// and should be polled again next frame.
+    ///
+    /// `out_len` is in/out with the same semantics as the other `_into`
+    /// calls. When the output buffer is too small the required size is
+    /// written to `out_len` and the already-encoded response is stashed;
+    /// retrying with the same request bytes serves the stash as a pure
+    /// copy, so context updates and input submissions are applied exactly
+    /// once and no polled response or issued handle is lost.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_tick_batch(
+        buf: *const u8,
+        len: u32,
+        out: *mut u8,
+        out_len: *mut u32,
+    ) -> i32 {
+        use crate::oxyde_game::bindings::batch_codec::{
+            self, BatchResponse, CompletedResponse,
+        };
+
+        if buf.is_null() || out.is_null() || out_len.is_null() {
+            return OXYDE_BUFFER_ERROR;
+        }
+
+        let bytes = unsafe { std::slice::from_raw_parts(buf, len as usize) };
+
+        // A previous call on this request already ran the batch and stashed
+        // its response because the output buffer was too small; serve the
+        // stash rather than submitting every input a second time
+        {
+            let mut stash = STASHED_BATCH.lock().unwrap_or_else(|p| p.into_inner());
+            if let Some(stashed) = stash.take() {
+                if stashed.request == bytes {
+                    let status = write_bytes_to_buffer(&stashed.encoded, out, out_len);
+                    if status == OXYDE_BUFFER_OK {
+                        let mut responses =
+                            ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+                        for handle in &stashed.completed {
+                            responses.remove(handle);
+                        }
+                    } else {
+                        // Still too small (or bad pointers); keep the stash
+                        // for the next retry
+                        *stash = Some(stashed);
+                    }
+                    return status;
+                }
+                // A different batch arrived instead of a retry: drop the
+                // stale stash. Its unclaimed responses are still in
+                // ASYNC_RESPONSES and will be returned by a later poll.
+            }
+        }
+
+        let request = match batch_codec::decode_batch_request(bytes) {
+            Ok(request) => request,
+            Err(_) => return OXYDE_BUFFER_ERROR,
+        };
+
+        let binding = get_binding();
+
+        // Apply context updates off the game thread, one task per agent
+        for (agent_id, context) in request.updates {
+            if let Ok(agent) = binding.get_agent(&agent_id) {
+                RUNTIME.spawn(async move {
+                    agent.update_context(context).await;
+                });
+            }
+        }
+
+        // Submit queued inputs through the same path as the per-agent
+        // async entry point
+        let issued_handles: Vec<u64> = request
+            .inputs
+            .into_iter()
+            .map(|(agent_id, input)| submit_async_input(&agent_id, input))
+            .collect();
+
+        // Gather completed responses without consuming them yet, so a
+        // too-small output buffer loses nothing
+        let mut responses = ASYNC_RESPONSES.lock().unwrap_or_else(|p| p.into_inner());
+        let mut completed = Vec::new();
+        for &handle in &request.polls {
+            match responses.get(&handle) {
+                Some(AsyncResponseState::Ready(text)) => completed.push(CompletedResponse {
+                    handle,
+                    text: text.clone(),
+                    success: true,
+                }),
+                Some(AsyncResponseState::Failed(text)) => completed.push(CompletedResponse {
+                    handle,
+                    text: text.clone(),
+                    success: false,
+                }),
+                Some(AsyncResponseState::Pending) | None => {}
+            }
+        }
+
+        let response = BatchResponse { issued_handles, completed };
+        let encoded = match batch_codec::encode_batch_response(&response) {
+            Ok(encoded) => encoded,
+            Err(_) => return OXYDE_BUFFER_ERROR,
+        };
+
+        let status = write_bytes_to_buffer(&encoded, out, out_len);
+        if status == OXYDE_BUFFER_OK {
+            for completed in &response.completed {
+                responses.remove(&completed.handle);
+            }
+        } else if status == OXYDE_BUFFER_TOO_SMALL {
+            // The batch has already run; hold the encoded response for the
+            // grow-and-retry call so nothing is executed twice
+            let mut stash = STASHED_BATCH.lock().unwrap_or_else(|p| p.into_inner());
+            *stash = Some(StashedBatchResponse {
+                request: bytes.to_vec(),
+                encoded,
+                completed: response.completed.iter().map(|c| c.handle).collect(),
+            });
+        }
+        status
+    }
+
     #[no_mangle]
     pub extern "C" fn oxyde_unreal_get_agent_state(agent_id: FfiStr) -> *mut c_char {
         let binding = get_binding();
@@ -294,6 +868,57 @@ pub mod ffi {
         }
     }
     
+    /// Get agent state as JSON into a caller-provided buffer
+    ///
+    /// Buffer-reuse variant of `oxyde_unreal_get_agent_state`. The state
+    /// JSON is formatted into a per-thread scratch string and copied into
+    /// `buf`, so polling agent state every frame performs no allocations
+    /// once the scratch and caller buffers have warmed up.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_get_agent_state_into(
+        agent_id: FfiStr,
+        buf: *mut c_char,
+        buf_len: *mut u32,
+    ) -> i32 {
+        use std::fmt::Write;
+
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+
+        let agent = match binding.get_agent(&agent_id_str) {
+            Ok(agent) => agent,
+            Err(_) => return OXYDE_BUFFER_ERROR,
+        };
+
+        SCRATCH.with(|scratch| {
+            let mut state_json = scratch.borrow_mut();
+            state_json.clear();
+            let _ = write!(
+                state_json,
+                "{{\"id\":\"{}\",\"name\":\"{}\"}}",
+                agent.id(),
+                agent.name()
+            );
+            write_to_buffer(&state_json, buf, buf_len)
+        })
+    }
+
+    /// Get a JSON snapshot of the SDK metrics registry
+    ///
+    /// Covers latency histograms and counters for the SDK hot paths
+    /// (process_input, memory retrieval, TTS). The returned string must be
+    /// freed with `oxyde_unreal_free_string`.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_get_metrics() -> *mut c_char {
+        string_to_ptr(crate::metrics::global().snapshot_json())
+    }
+
+    /// Enable or disable SDK metric recording
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_set_metrics_enabled(enabled: bool) {
+        crate::metrics::set_enabled(enabled);
+    }
+
     /// Get agent emotion vector
     #[no_mangle]
     pub extern "C" fn oxyde_unreal_get_emotion_vector(
@@ -571,6 +1196,45 @@ pub mod ffi {
         }
     }
 
+    /// Save an agent's memories to a binary snapshot file
+    ///
+    /// Returns the number of memories written, or 0 on failure.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_save_memory_snapshot(agent_id: FfiStr, path: FfiStr) -> u32 {
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+        let path_str = path.into_string();
+
+        match binding.get_agent(&agent_id_str) {
+            Ok(agent) => {
+                RUNTIME.block_on(async {
+                    agent.save_memory_snapshot(&path_str).await.unwrap_or(0) as u32
+                })
+            },
+            Err(_) => 0,
+        }
+    }
+
+    /// Load an agent's memories from a binary snapshot file
+    ///
+    /// Replaces the agent's current memories. Returns the number of memories
+    /// loaded, or 0 on failure.
+    #[no_mangle]
+    pub extern "C" fn oxyde_unreal_load_memory_snapshot(agent_id: FfiStr, path: FfiStr) -> u32 {
+        let binding = get_binding();
+        let agent_id_str = agent_id.into_string();
+        let path_str = path.into_string();
+
+        match binding.get_agent(&agent_id_str) {
+            Ok(agent) => {
+                RUNTIME.block_on(async {
+                    agent.load_memory_snapshot(&path_str).await.unwrap_or(0) as u32
+                })
+            },
+            Err(_) => 0,
+        }
+    }
+
     // ==================== End Memory System FFI ====================
 
     /// Free a string allocated by the Oxyde SDK
@@ -3,12 +3,128 @@
 //! This module provides functionality for understanding player intent from
 //! their actions, chat messages, and other interactions.
 
-use std::collections::HashSet;
+use std::collections::{HashMap, HashSet};
+use std::sync::RwLock;
 
+use aho_corasick::{AhoCorasick, AhoCorasickBuilder};
+use lazy_static::lazy_static;
 use serde::{Deserialize, Serialize};
 
 use crate::{OxydeError, Result};
 
+/// Greeting phrases recognized by the intent classifier
+const GREETINGS: [&str; 11] = [
+    "hello", "hi", "hey", "greetings", "good morning",
+    "good afternoon", "good evening", "howdy", "sup",
+    "what's up", "hiya",
+];
+
+/// Command prefixes recognized by the intent classifier
+const COMMAND_PREFIXES: [&str; 17] = [
+    "follow", "go", "attack", "defend", "run", "wait",
+    "stop", "help", "give", "take", "use", "open",
+    "close", "find", "look", "examine", "talk",
+];
+
+lazy_static! {
+    /// Single case-insensitive multi-pattern automaton over greetings and
+    /// command prefixes, compiled once. Classification is one scan of the
+    /// input instead of a linear probe per phrase with lowercase copies.
+    static ref PHRASE_MATCHER: AhoCorasick = AhoCorasickBuilder::new()
+        .ascii_case_insensitive(true)
+        .build(GREETINGS.iter().chain(COMMAND_PREFIXES.iter()))
+        .expect("intent phrase patterns are valid");
+
+    /// Stopwords skipped during keyword extraction, built once
+    static ref STOPWORDS: HashSet<&'static str> = [
+        "the", "a", "an", "and", "or", "but", "in", "on", "at", "to", "for",
+        "with", "by", "about", "against", "between", "into", "through",
+        "is", "are", "was", "were", "be", "been", "being",
+        "i", "you", "he", "she", "it", "we", "they",
+        "my", "your", "his", "her", "its", "our", "their",
+    ].iter().cloned().collect();
+
+    /// Process-wide keyword intern table mapping keyword strings to dense IDs
+    static ref KEYWORD_INTERNER: RwLock<HashMap<String, u32>> =
+        RwLock::new(HashMap::new());
+}
+
+/// Intern a keyword, returning its process-wide dense ID
+///
+/// # Arguments
+///
+/// * `keyword` - Keyword to intern (expected lowercase, as produced by
+///   `extract_keywords`)
+///
+/// # Returns
+///
+/// The stable ID assigned to the keyword
+pub fn intern_keyword(keyword: &str) -> u32 {
+    {
+        let interner = KEYWORD_INTERNER.read().unwrap_or_else(|p| p.into_inner());
+        if let Some(&id) = interner.get(keyword) {
+            return id;
+        }
+    }
+    let mut interner = KEYWORD_INTERNER.write().unwrap_or_else(|p| p.into_inner());
+    let next_id = interner.len() as u32;
+    *interner.entry(keyword.to_string()).or_insert(next_id)
+}
+
+/// Look up a keyword's ID without interning it
+///
+/// # Returns
+///
+/// The keyword's ID, or None if it has never been interned
+pub fn lookup_keyword(keyword: &str) -> Option<u32> {
+    let interner = KEYWORD_INTERNER.read().unwrap_or_else(|p| p.into_inner());
+    interner.get(keyword).copied()
+}
+
+/// Small set of interned keyword IDs with a 64-bit filter for O(1) rejects
+///
+/// Membership tests check the filter bit first, so the common miss case is a
+/// single mask test; hits confirm against the (short) sorted ID list.
+#[derive(Debug, Clone, Default, PartialEq)]
+pub struct KeywordSet {
+    bits: u64,
+    ids: Vec<u32>,
+}
+
+impl KeywordSet {
+    /// Build a keyword set by interning the given keywords
+    pub fn from_keywords(keywords: &[String]) -> Self {
+        let mut set = Self::default();
+        for keyword in keywords {
+            set.insert(intern_keyword(keyword));
+        }
+        set
+    }
+
+    /// Insert an interned keyword ID
+    pub fn insert(&mut self, id: u32) {
+        self.bits |= 1u64 << (id % 64);
+        if let Err(slot) = self.ids.binary_search(&id) {
+            self.ids.insert(slot, id);
+        }
+    }
+
+    /// Check whether the set contains an interned keyword ID
+    pub fn contains(&self, id: u32) -> bool {
+        self.bits & (1u64 << (id % 64)) != 0 && self.ids.binary_search(&id).is_ok()
+    }
+
+    /// Get the number of keywords in the set
+    pub fn len(&self) -> usize {
+        self.ids.len()
+    }
+
+    /// Check whether the set is empty
+    pub fn is_empty(&self) -> bool {
+        self.ids.is_empty()
+    }
+}
+
 /// Type of player intent
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
 #[serde(rename_all = "lowercase")]
@@ -96,6 +212,10 @@ pub struct Intent {
 
     /// Keywords extracted from the input
     pub keywords: Vec<String>,
+
+    /// Interned IDs of the extracted keywords, for O(1) membership tests
+    #[serde(skip, default)]
+    pub keyword_ids: KeywordSet,
 }
 
 impl Intent {
@@ -117,11 +237,13 @@ impl Intent {
         raw_input: &str,
         keywords: Vec<String>,
     ) -> Self {
+        let keyword_ids = KeywordSet::from_keywords(&keywords);
         Self {
             intent_type,
             confidence: confidence.clamp(0.0, 1.0),
             raw_input: raw_input.to_string(),
             keywords,
+            keyword_ids,
         }
     }
     
@@ -205,22 +327,15 @@ impl Intent {
     /// Vector of extracted keywords
     pub fn extract_keywords(text: &str) -> Vec<String> {
         let mut keywords = Vec::new();
-        let stopwords: HashSet<&str> = [
-            "the", "a", "an", "and", "or", "but", "in", "on", "at", "to", "for",
-            "with", "by", "about", "against", "between", "into", "through",
-            "is", "are", "was", "were", "be", "been", "being",
-            "i", "you", "he", "she", "it", "we", "they",
-            "my", "your", "his", "her", "its", "our", "their",
-        ].iter().cloned().collect();
-        
+
         for word in text.split_whitespace() {
             // Remove punctuation from the word
             let clean_word = word.trim_matches(|c: char| !c.is_alphanumeric()).to_lowercase();
-            if clean_word.len() > 2 && !stopwords.contains(clean_word.as_str()) {
+            if clean_word.len() > 2 && !STOPWORDS.contains(clean_word.as_str()) {
                 keywords.push(clean_word);
             }
         }
-        
+
         keywords
     }
     
@@ -234,20 +349,9 @@ impl Intent {
     ///
     /// Whether the text is a greeting
     fn is_greeting(text: &str) -> bool {
-        let greetings = [
-            "hello", "hi", "hey", "greetings", "good morning",
-            "good afternoon", "good evening", "howdy", "sup",
-            "what's up", "hiya",
-        ];
-        
-        let text_lower = text.to_lowercase();
-        // Check if the text starts with a greeting or contains it as a whole word
-        greetings.iter().any(|g| {
-            text_lower.starts_with(g) || 
-            text_lower.split_whitespace().any(|word| word == *g)
-        })
+        Self::classify_phrases(text).0
     }
-    
+
     /// Check if text is a command
     ///
     /// # Arguments
@@ -258,14 +362,39 @@ impl Intent {
     ///
     /// Whether the text is a command
     fn is_command(text: &str) -> bool {
-        let command_prefixes = [
-            "follow", "go", "attack", "defend", "run", "wait",
-            "stop", "help", "give", "take", "use", "open",
-            "close", "find", "look", "examine", "talk",
-        ];
-        
-        let text_lower = text.to_lowercase();
-        command_prefixes.iter().any(|c| text_lower.starts_with(c))
+        Self::classify_phrases(text).1
+    }
+
+    /// Scan the input once through the compiled phrase automaton
+    ///
+    /// # Returns
+    ///
+    /// `(is_greeting, is_command)`: a greeting pattern counts when it opens
+    /// the text or appears word-bounded anywhere; a command prefix counts
+    /// only at the start of the text
+    fn classify_phrases(text: &str) -> (bool, bool) {
+        let bytes = text.as_bytes();
+        let mut greeting = false;
+        let mut command = false;
+
+        for m in PHRASE_MATCHER.find_overlapping_iter(text) {
+            if m.pattern().as_usize() < GREETINGS.len() {
+                let bounded_before =
+                    m.start() == 0 || !bytes[m.start() - 1].is_ascii_alphanumeric();
+                let bounded_after =
+                    m.end() == bytes.len() || !bytes[m.end()].is_ascii_alphanumeric();
+                if m.start() == 0 || (bounded_before && bounded_after) {
+                    greeting = true;
+                }
+            } else if m.start() == 0 {
+                command = true;
+            }
+            if greeting && command {
+                break;
+            }
+        }
+
+        (greeting, command)
     }
     
     /// Check if the intent has a specific keyword
@@ -278,7 +407,12 @@ impl Intent {
     ///
     /// Whether the intent contains the keyword
     pub fn has_keyword(&self, keyword: &str) -> bool {
-        self.keywords.iter().any(|k| k == keyword)
+        // A keyword that was never interned cannot be in any intent; an
+        // interned one is answered by the bitset without a string compare
+        match lookup_keyword(keyword) {
+            Some(id) => self.keyword_ids.contains(id),
+            None => false,
+        }
     }
 }
 
@@ -308,4 +442,35 @@ mod tests {
         assert!(keywords.contains(&"france".to_string()));
         assert!(!keywords.contains(&"is".to_string())); // Stopword should be filtered
     }
+
+    #[test]
+    fn test_interned_keyword_lookup() {
+        let intent = Intent::from_chat("follow the merchant to the market");
+        assert!(intent.has_keyword("merchant"));
+        assert!(intent.has_keyword("follow"));
+        // Never-interned words are rejected without touching the ID set
+        assert!(!intent.has_keyword("xyzzy-never-interned"));
+        assert_eq!(intent.keyword_ids.len(), intent.keywords.len());
+    }
+
+    #[test]
+    fn test_keyword_set_membership() {
+        let mut set = KeywordSet::default();
+        set.insert(3);
+        set.insert(67); // Collides with 3 in the 64-bit filter
+        assert!(set.contains(3));
+        assert!(set.contains(67));
+        assert!(!set.contains(131)); // Same filter bit, absent from the set
+        assert!(!set.contains(4));
+        assert_eq!(set.len(), 2);
+    }
+
+    #[test]
+    fn test_case_insensitive_classification() {
+        assert_eq!(Intent::from_chat("HELLO there").intent_type, IntentType::Greeting);
+        assert_eq!(Intent::from_chat("Good morning friend").intent_type, IntentType::Greeting);
+        assert_eq!(Intent::from_chat("STOP right there").intent_type, IntentType::Command);
+        // Command prefixes only count at the start of the text
+        assert_eq!(Intent::from_chat("they all stop").intent_type, IntentType::Chat);
+    }
 }
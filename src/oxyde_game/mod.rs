@@ -7,6 +7,7 @@
 pub mod behavior;
 pub mod emotion;
 pub mod intent;
+pub mod pathfinding;
 pub mod bindings;
 
 /// Game-specific utilities and extensions
@@ -1,123 +1,456 @@
+//! Grid-based pathfinding for NPC movement
+//!
+//! This module provides an A* pathfinding engine over a navigation grid.
+//! Obstacles are stored in a hashed cell index for O(1) occupancy checks,
+//! and [`PathFinder`] keeps its open/closed sets between queries so patrol
+//! behaviors that path every AI tick don't reallocate per call. Repeated
+//! start/goal pairs are served from a small cache that is invalidated
+//! whenever the grid changes.
 
-use std::collections::{BinaryHeap, HashMap};
 use std::cmp::Ordering;
+use std::collections::hash_map::Entry;
+use std::collections::{BinaryHeap, HashMap, HashSet};
 
+/// Default limit on the number of nodes a single search may expand
+const DEFAULT_MAX_EXPANSIONS: usize = 16_384;
+
+/// Maximum number of cached paths kept by a [`PathFinder`]
+const PATH_CACHE_CAPACITY: usize = 64;
+
+/// Position in 2D space
 #[derive(Debug, Clone, PartialEq)]
 pub struct Position {
+    /// X coordinate
     pub x: f32,
+    /// Y coordinate
     pub y: f32,
 }
 
+impl Position {
+    /// Create a new position
+    pub fn new(x: f32, y: f32) -> Self {
+        Self { x, y }
+    }
+
+    /// Snap the position to its containing grid cell
+    fn to_cell(&self) -> Cell {
+        (self.x.round() as i32, self.y.round() as i32)
+    }
+}
+
+/// Integer grid cell used as the unit of navigation
+type Cell = (i32, i32);
+
+fn cell_position(cell: Cell) -> Position {
+    Position {
+        x: cell.0 as f32,
+        y: cell.1 as f32,
+    }
+}
+
+/// Navigation grid with an indexed obstacle set
+///
+/// Occupancy checks are O(1) hash lookups regardless of how many obstacle
+/// cells the map contains. The grid tracks a revision counter so path
+/// caches can detect stale results after obstacles change.
+#[derive(Debug, Default)]
+pub struct NavGrid {
+    obstacles: HashSet<Cell>,
+    revision: u64,
+}
+
+impl NavGrid {
+    /// Create an empty navigation grid
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Create a grid from a slice of obstacle positions
+    ///
+    /// # Arguments
+    ///
+    /// * `obstacles` - Positions of blocked cells
+    ///
+    /// # Returns
+    ///
+    /// Grid with the given cells marked as blocked
+    pub fn from_obstacles(obstacles: &[Position]) -> Self {
+        let mut grid = Self::new();
+        for obstacle in obstacles {
+            grid.obstacles.insert(obstacle.to_cell());
+        }
+        grid
+    }
+
+    /// Mark the cell containing a position as blocked
+    pub fn add_obstacle(&mut self, position: &Position) {
+        if self.obstacles.insert(position.to_cell()) {
+            self.revision += 1;
+        }
+    }
+
+    /// Clear the cell containing a position
+    pub fn remove_obstacle(&mut self, position: &Position) {
+        if self.obstacles.remove(&position.to_cell()) {
+            self.revision += 1;
+        }
+    }
+
+    /// Check whether the cell containing a position is blocked
+    pub fn is_blocked(&self, position: &Position) -> bool {
+        self.obstacles.contains(&position.to_cell())
+    }
+
+    /// Number of blocked cells in the grid
+    pub fn obstacle_count(&self) -> usize {
+        self.obstacles.len()
+    }
+
+    fn is_cell_blocked(&self, cell: Cell) -> bool {
+        self.obstacles.contains(&cell)
+    }
+}
+
+/// Entry in the open-set heap, ordered by lowest f-score first
 #[derive(Debug)]
-pub struct Node {
-    position: Position,
+struct OpenEntry {
+    cell: Cell,
     f_score: f32,
     g_score: f32,
-    parent: Option<Box<Node>>,
 }
 
-impl PartialEq for Node {
+impl PartialEq for OpenEntry {
     fn eq(&self, other: &Self) -> bool {
-        self.position == other.position
+        self.f_score == other.f_score
     }
 }
 
-impl Eq for Node {}
+impl Eq for OpenEntry {}
 
-impl PartialOrd for Node {
+impl PartialOrd for OpenEntry {
     fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
-        other.f_score.partial_cmp(&self.f_score)
+        Some(self.cmp(other))
     }
 }
 
-impl Ord for Node {
+impl Ord for OpenEntry {
     fn cmp(&self, other: &Self) -> Ordering {
-        self.partial_cmp(other).unwrap_or(Ordering::Equal)
+        // Reversed so the BinaryHeap pops the lowest f-score
+        other
+            .f_score
+            .partial_cmp(&self.f_score)
+            .unwrap_or(Ordering::Equal)
     }
 }
 
-pub fn find_path(start: Position, goal: Position, obstacles: &[Position]) -> Option<Vec<Position>> {
-    let mut open_set = BinaryHeap::new();
-    let mut closed_set = HashMap::new();
-    
-    let start_node = Node {
-        position: start.clone(),
-        f_score: heuristic(&start, &goal),
-        g_score: 0.0,
-        parent: None,
-    };
-    
-    open_set.push(start_node);
-    
-    while let Some(current) = open_set.pop() {
-        if current.position == goal {
-            return Some(reconstruct_path(&current));
+/// Reusable A* search context with a per-grid path cache
+///
+/// Keep one `PathFinder` per agent (or share one per map) and call
+/// [`PathFinder::find_path`] each tick; the open set, score map, and
+/// parent map are cleared and reused instead of reallocated, and repeated
+/// start/goal queries against an unchanged grid return cached paths.
+#[derive(Debug)]
+pub struct PathFinder {
+    open_set: BinaryHeap<OpenEntry>,
+    g_scores: HashMap<Cell, f32>,
+    came_from: HashMap<Cell, Cell>,
+    cache: HashMap<(Cell, Cell), Option<Vec<Position>>>,
+    cache_revision: u64,
+    max_expansions: usize,
+}
+
+impl Default for PathFinder {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl PathFinder {
+    /// Create a path finder with the default expansion limit
+    pub fn new() -> Self {
+        Self::with_max_expansions(DEFAULT_MAX_EXPANSIONS)
+    }
+
+    /// Create a path finder with a custom expansion limit
+    ///
+    /// # Arguments
+    ///
+    /// * `max_expansions` - Maximum nodes a single search may expand
+    ///   before giving up (bounds worst-case cost when the goal is
+    ///   unreachable)
+    pub fn with_max_expansions(max_expansions: usize) -> Self {
+        Self {
+            open_set: BinaryHeap::new(),
+            g_scores: HashMap::new(),
+            came_from: HashMap::new(),
+            cache: HashMap::new(),
+            cache_revision: 0,
+            max_expansions,
+        }
+    }
+
+    /// Find a path between two positions on the grid
+    ///
+    /// # Arguments
+    ///
+    /// * `grid` - Navigation grid to search
+    /// * `start` - Starting position
+    /// * `goal` - Goal position
+    ///
+    /// # Returns
+    ///
+    /// Positions from start to goal inclusive, or `None` if no path was
+    /// found within the expansion limit
+    pub fn find_path(
+        &mut self,
+        grid: &NavGrid,
+        start: &Position,
+        goal: &Position,
+    ) -> Option<Vec<Position>> {
+        let start_cell = start.to_cell();
+        let goal_cell = goal.to_cell();
+
+        // Drop cached paths computed against an older grid
+        if self.cache_revision != grid.revision {
+            self.cache.clear();
+            self.cache_revision = grid.revision;
+        }
+
+        if let Some(cached) = self.cache.get(&(start_cell, goal_cell)) {
+            return cached.clone();
+        }
+
+        let path = self.search(grid, start_cell, goal_cell);
+
+        if self.cache.len() >= PATH_CACHE_CAPACITY {
+            self.cache.clear();
+        }
+        self.cache.insert((start_cell, goal_cell), path.clone());
+
+        path
+    }
+
+    fn search(&mut self, grid: &NavGrid, start: Cell, goal: Cell) -> Option<Vec<Position>> {
+        if grid.is_cell_blocked(goal) {
+            return None;
         }
-        
-        closed_set.insert((current.position.x, current.position.y), current.g_score);
-        
-        for neighbor in get_neighbors(&current.position, obstacles) {
-            let g_score = current.g_score + distance(&current.position, &neighbor);
-            
-            if let Some(&best_g) = closed_set.get(&(neighbor.x, neighbor.y)) {
-                if g_score >= best_g {
+
+        self.open_set.clear();
+        self.g_scores.clear();
+        self.came_from.clear();
+
+        self.open_set.push(OpenEntry {
+            cell: start,
+            f_score: heuristic(start, goal),
+            g_score: 0.0,
+        });
+        self.g_scores.insert(start, 0.0);
+
+        let mut expansions = 0;
+
+        while let Some(current) = self.open_set.pop() {
+            if current.cell == goal {
+                return Some(self.reconstruct_path(start, goal));
+            }
+
+            // Skip stale heap entries superseded by a cheaper route
+            if current.g_score > self.g_scores.get(&current.cell).copied().unwrap_or(f32::MAX) {
+                continue;
+            }
+
+            expansions += 1;
+            if expansions > self.max_expansions {
+                return None;
+            }
+
+            for (neighbor, step_cost) in neighbors(current.cell) {
+                if grid.is_cell_blocked(neighbor) {
                     continue;
                 }
+
+                let g_score = current.g_score + step_cost;
+
+                match self.g_scores.entry(neighbor) {
+                    Entry::Occupied(mut entry) => {
+                        if g_score >= *entry.get() {
+                            continue;
+                        }
+                        entry.insert(g_score);
+                    }
+                    Entry::Vacant(entry) => {
+                        entry.insert(g_score);
+                    }
+                }
+
+                self.came_from.insert(neighbor, current.cell);
+                self.open_set.push(OpenEntry {
+                    cell: neighbor,
+                    f_score: g_score + heuristic(neighbor, goal),
+                    g_score,
+                });
             }
-            
-            let h_score = heuristic(&neighbor, &goal);
-            let f_score = g_score + h_score;
-            
-            let neighbor_node = Node {
-                position: neighbor,
-                f_score,
-                g_score,
-                parent: Some(Box::new(current.clone())),
-            };
-            
-            open_set.push(neighbor_node);
         }
+
+        None
     }
-    
-    None
+
+    fn reconstruct_path(&self, start: Cell, goal: Cell) -> Vec<Position> {
+        let mut path = vec![cell_position(goal)];
+        let mut current = goal;
+
+        while current != start {
+            match self.came_from.get(&current) {
+                Some(&parent) => {
+                    path.push(cell_position(parent));
+                    current = parent;
+                }
+                None => break,
+            }
+        }
+
+        path.reverse();
+        path
+    }
+}
+
+/// Find a path between two positions, avoiding obstacles
+///
+/// Convenience wrapper that builds a one-shot [`NavGrid`] and
+/// [`PathFinder`]. Callers that path repeatedly should hold onto both
+/// and use [`PathFinder::find_path`] directly to benefit from reused
+/// search state and the path cache.
+///
+/// # Arguments
+///
+/// * `start` - Starting position
+/// * `goal` - Goal position
+/// * `obstacles` - Positions of blocked cells
+///
+/// # Returns
+///
+/// Positions from start to goal inclusive, or `None` if no path exists
+pub fn find_path(start: Position, goal: Position, obstacles: &[Position]) -> Option<Vec<Position>> {
+    let grid = NavGrid::from_obstacles(obstacles);
+    let mut finder = PathFinder::new();
+    finder.find_path(&grid, &start, &goal)
 }
 
-fn heuristic(a: &Position, b: &Position) -> f32 {
-    let dx = b.x - a.x;
-    let dy = b.y - a.y;
+fn heuristic(a: Cell, b: Cell) -> f32 {
+    let dx = (b.0 - a.0) as f32;
+    let dy = (b.1 - a.1) as f32;
     (dx * dx + dy * dy).sqrt()
 }
 
-fn distance(a: &Position, b: &Position) -> f32 {
-    heuristic(a, b)
-}
-
-fn get_neighbors(pos: &Position, obstacles: &[Position]) -> Vec<Position> {
-    let dirs = [
-        (1.0, 0.0), (-1.0, 0.0),
-        (0.0, 1.0), (0.0, -1.0),
-        (1.0, 1.0), (-1.0, -1.0),
-        (1.0, -1.0), (-1.0, 1.0),
-    ];
-    
-    dirs.iter()
-        .map(|(dx, dy)| Position {
-            x: pos.x + dx,
-            y: pos.y + dy,
-        })
-        .filter(|p| !obstacles.contains(p))
-        .collect()
-}
-
-fn reconstruct_path(end_node: &Node) -> Vec<Position> {
-    let mut path = vec![end_node.position.clone()];
-    let mut current = end_node;
-    
-    while let Some(ref parent) = current.parent {
-        path.push(parent.position.clone());
-        current = parent;
-    }
-    
-    path.reverse();
-    path
+const SQRT_2: f32 = std::f32::consts::SQRT_2;
+
+fn neighbors(cell: Cell) -> [(Cell, f32); 8] {
+    let (x, y) = cell;
+    [
+        ((x + 1, y), 1.0),
+        ((x - 1, y), 1.0),
+        ((x, y + 1), 1.0),
+        ((x, y - 1), 1.0),
+        ((x + 1, y + 1), SQRT_2),
+        ((x - 1, y - 1), SQRT_2),
+        ((x + 1, y - 1), SQRT_2),
+        ((x - 1, y + 1), SQRT_2),
+    ]
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_straight_path() {
+        let path = find_path(Position::new(0.0, 0.0), Position::new(3.0, 0.0), &[]);
+
+        let path = path.expect("path should exist on an empty grid");
+        assert_eq!(path.first(), Some(&Position::new(0.0, 0.0)));
+        assert_eq!(path.last(), Some(&Position::new(3.0, 0.0)));
+        assert_eq!(path.len(), 4);
+    }
+
+    #[test]
+    fn test_path_around_obstacle_wall() {
+        // Vertical wall at x=2 with no gap near the route
+        let obstacles: Vec<Position> = (-3..=3).map(|y| Position::new(2.0, y as f32)).collect();
+
+        let path = find_path(Position::new(0.0, 0.0), Position::new(4.0, 0.0), &obstacles)
+            .expect("path should route around the wall");
+
+        for position in &path {
+            assert!(!obstacles.contains(position));
+        }
+        assert_eq!(path.last(), Some(&Position::new(4.0, 0.0)));
+        // Detour must be longer than the direct 5-cell route
+        assert!(path.len() > 5);
+    }
+
+    #[test]
+    fn test_blocked_goal_returns_none() {
+        let goal = Position::new(2.0, 2.0);
+        let path = find_path(Position::new(0.0, 0.0), goal.clone(), &[goal]);
+        assert!(path.is_none());
+    }
+
+    #[test]
+    fn test_unreachable_goal_bounded() {
+        // Goal fully enclosed by obstacles; the expansion limit must stop
+        // the search instead of scanning the infinite grid
+        let obstacles = vec![
+            Position::new(4.0, 4.0),
+            Position::new(4.0, 5.0),
+            Position::new(4.0, 6.0),
+            Position::new(5.0, 4.0),
+            Position::new(5.0, 6.0),
+            Position::new(6.0, 4.0),
+            Position::new(6.0, 5.0),
+            Position::new(6.0, 6.0),
+        ];
+
+        let grid = NavGrid::from_obstacles(&obstacles);
+        let mut finder = PathFinder::with_max_expansions(1000);
+        let path = finder.find_path(&grid, &Position::new(0.0, 0.0), &Position::new(5.0, 5.0));
+        assert!(path.is_none());
+    }
+
+    #[test]
+    fn test_path_cache_invalidated_on_grid_change() {
+        let mut grid = NavGrid::new();
+        let mut finder = PathFinder::new();
+        let start = Position::new(0.0, 0.0);
+        let goal = Position::new(3.0, 0.0);
+
+        let direct = finder
+            .find_path(&grid, &start, &goal)
+            .expect("direct path should exist");
+
+        // Same query again is served from cache
+        let cached = finder.find_path(&grid, &start, &goal).unwrap();
+        assert_eq!(direct, cached);
+
+        // Blocking the route must invalidate the cached path
+        for y in -2..=2 {
+            grid.add_obstacle(&Position::new(1.0, y as f32));
+        }
+        let detour = finder
+            .find_path(&grid, &start, &goal)
+            .expect("detour should exist");
+        assert!(detour.len() > direct.len());
+    }
+
+    #[test]
+    fn test_nav_grid_occupancy() {
+        let mut grid = NavGrid::new();
+        let cell = Position::new(1.0, 1.0);
+
+        assert!(!grid.is_blocked(&cell));
+        grid.add_obstacle(&cell);
+        assert!(grid.is_blocked(&cell));
+        assert_eq!(grid.obstacle_count(), 1);
+
+        grid.remove_obstacle(&cell);
+        assert!(!grid.is_blocked(&cell));
+    }
 }
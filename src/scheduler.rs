@@ -0,0 +1,350 @@
+//! Batched tick scheduling for crowds of agents
+//!
+//! This module provides the [`AgentScheduler`], which owns a pool of agents and
+//! drives them in batches instead of per-agent, per-frame calls. Emotion decay
+//! runs as a single pass over every agent's emotion state, and inference work is
+//! time-sliced so only a bounded number of agents hit the LLM per tick. This is
+//! designed for crowd-heavy servers running hundreds of agents, where the
+//! per-agent lock and task overhead of driving each agent individually becomes
+//! a frame-time problem.
+
+use std::collections::VecDeque;
+use std::sync::Arc;
+
+use tokio::sync::{Mutex, RwLock};
+use uuid::Uuid;
+
+use crate::agent::Agent;
+use crate::{OxydeError, Result};
+
+/// Configuration for the agent scheduler
+#[derive(Debug, Clone)]
+pub struct SchedulerConfig {
+    /// Maximum number of agents whose queued inputs are dispatched to
+    /// inference per tick. Remaining inputs stay queued for later ticks.
+    pub max_inference_per_tick: usize,
+
+    /// How many ticks pass between emotion decay passes. A value of 1 decays
+    /// emotions on every tick.
+    pub decay_interval_ticks: u64,
+}
+
+impl Default for SchedulerConfig {
+    fn default() -> Self {
+        Self {
+            max_inference_per_tick: 4,
+            decay_interval_ticks: 1,
+        }
+    }
+}
+
+/// A queued player input waiting for its inference time slice
+#[derive(Debug)]
+struct PendingInput {
+    agent_id: Uuid,
+    input: String,
+}
+
+/// A completed agent response produced by a previous tick
+#[derive(Debug)]
+pub struct AgentResponse {
+    /// ID of the agent that produced the response
+    pub agent_id: Uuid,
+
+    /// Input that triggered the response
+    pub input: String,
+
+    /// The response text, or the error if processing failed
+    pub response: Result<String>,
+}
+
+/// Statistics about a single scheduler tick
+#[derive(Debug, Clone, Copy, Default)]
+pub struct TickStats {
+    /// Number of agents whose emotions were decayed this tick
+    pub agents_decayed: usize,
+
+    /// Number of inputs dispatched to inference this tick
+    pub inference_dispatched: usize,
+
+    /// Number of inputs still queued after this tick
+    pub inference_queued: usize,
+}
+
+/// Scheduler that ticks a pool of agents in batches
+///
+/// The scheduler amortizes per-agent overhead in two ways:
+///
+/// 1. **Batched emotion decay** — instead of each caller acquiring each
+///    agent's emotion lock separately, the scheduler locks and decays all
+///    agents in one pass per tick.
+/// 2. **Time-sliced inference** — player inputs are queued via
+///    [`queue_input`](Self::queue_input) and only
+///    `max_inference_per_tick` of them are dispatched per tick, bounding
+///    the per-frame inference cost. Completed responses are collected with
+///    [`drain_responses`](Self::drain_responses).
+pub struct AgentScheduler {
+    /// Scheduler configuration
+    config: SchedulerConfig,
+
+    /// Pool of agents driven by this scheduler
+    agents: RwLock<Vec<Arc<Agent>>>,
+
+    /// Inputs waiting for an inference time slice
+    pending_inputs: Mutex<VecDeque<PendingInput>>,
+
+    /// Responses completed by dispatched inference tasks
+    completed: Arc<Mutex<Vec<AgentResponse>>>,
+
+    /// Number of ticks executed so far
+    tick_count: Mutex<u64>,
+}
+
+impl AgentScheduler {
+    /// Create a new scheduler with the given configuration
+    pub fn new(config: SchedulerConfig) -> Self {
+        Self {
+            config,
+            agents: RwLock::new(Vec::new()),
+            pending_inputs: Mutex::new(VecDeque::new()),
+            completed: Arc::new(Mutex::new(Vec::new())),
+            tick_count: Mutex::new(0),
+        }
+    }
+
+    /// Add an agent to the scheduler pool
+    ///
+    /// # Arguments
+    ///
+    /// * `agent` - Agent to add
+    pub async fn add_agent(&self, agent: Arc<Agent>) {
+        let mut agents = self.agents.write().await;
+        agents.push(agent);
+    }
+
+    /// Remove an agent from the scheduler pool by ID
+    ///
+    /// # Returns
+    ///
+    /// Whether an agent with the given ID was found and removed
+    pub async fn remove_agent(&self, agent_id: Uuid) -> bool {
+        let mut agents = self.agents.write().await;
+        let initial_len = agents.len();
+        agents.retain(|a| a.id() != agent_id);
+        agents.len() != initial_len
+    }
+
+    /// Get the number of agents in the pool
+    pub async fn agent_count(&self) -> usize {
+        self.agents.read().await.len()
+    }
+
+    /// Queue a player input for an agent
+    ///
+    /// The input is processed during a later [`tick`](Self::tick) when the
+    /// agent gets an inference time slice; the response is retrieved via
+    /// [`drain_responses`](Self::drain_responses).
+    ///
+    /// # Arguments
+    ///
+    /// * `agent_id` - ID of the target agent
+    /// * `input` - Player input text
+    ///
+    /// # Returns
+    ///
+    /// An error if the agent is not in the pool
+    pub async fn queue_input(&self, agent_id: Uuid, input: &str) -> Result<()> {
+        let agents = self.agents.read().await;
+        if !agents.iter().any(|a| a.id() == agent_id) {
+            return Err(OxydeError::BehaviorError(format!(
+                "Agent {} is not registered with the scheduler",
+                agent_id
+            )));
+        }
+        drop(agents);
+
+        let mut pending = self.pending_inputs.lock().await;
+        pending.push_back(PendingInput {
+            agent_id,
+            input: input.to_string(),
+        });
+        Ok(())
+    }
+
+    /// Run one scheduler tick
+    ///
+    /// This decays emotions for every agent in a single batched pass (subject
+    /// to `decay_interval_ticks`) and dispatches up to
+    /// `max_inference_per_tick` queued inputs as background tasks.
+    ///
+    /// # Returns
+    ///
+    /// Statistics about the work performed this tick
+    pub async fn tick(&self) -> TickStats {
+        let mut stats = TickStats::default();
+
+        let tick = {
+            let mut count = self.tick_count.lock().await;
+            *count += 1;
+            *count
+        };
+
+        let agents = self.agents.read().await;
+
+        // Phase 1: emotion decay as one pass over the whole pool. Locks are
+        // acquired up front so the decay loop itself is a tight pass over the
+        // contiguous emotion states rather than an await per agent.
+        if self.config.decay_interval_ticks > 0 && tick % self.config.decay_interval_ticks == 0 {
+            let mut guards = Vec::with_capacity(agents.len());
+            for agent in agents.iter() {
+                guards.push(agent.emotional_state_cell().write().await);
+            }
+            for guard in guards.iter_mut() {
+                guard.decay();
+            }
+            stats.agents_decayed = guards.len();
+        }
+
+        // Phase 2: dispatch a bounded slice of queued inputs to inference.
+        let mut pending = self.pending_inputs.lock().await;
+        let slice = self.config.max_inference_per_tick.min(pending.len());
+
+        for _ in 0..slice {
+            let item = match pending.pop_front() {
+                Some(item) => item,
+                None => break,
+            };
+
+            let agent = agents.iter().find(|a| a.id() == item.agent_id).cloned();
+            let Some(agent) = agent else {
+                // Agent was removed after its input was queued; drop the input.
+                continue;
+            };
+
+            let completed = self.completed.clone();
+            tokio::spawn(async move {
+                let response = agent.process_input(&item.input).await;
+                let mut completed = completed.lock().await;
+                completed.push(AgentResponse {
+                    agent_id: item.agent_id,
+                    input: item.input,
+                    response,
+                });
+            });
+            stats.inference_dispatched += 1;
+        }
+
+        stats.inference_queued = pending.len();
+        stats
+    }
+
+    /// Take all responses completed since the last drain
+    ///
+    /// # Returns
+    ///
+    /// Vector of completed responses, in completion order
+    pub async fn drain_responses(&self) -> Vec<AgentResponse> {
+        let mut completed = self.completed.lock().await;
+        std::mem::take(&mut *completed)
+    }
+}
+
+impl std::fmt::Debug for AgentScheduler {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("AgentScheduler")
+            .field("config", &self.config)
+            .field("agents", &"<RwLock<Vec<Arc<Agent>>>>")
+            .finish()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::collections::HashMap;
+    use crate::config::{AgentConfig, AgentPersonality, InferenceConfig, MemoryConfig};
+    use crate::oxyde_game::behavior::GreetingBehavior;
+
+    fn test_config(name: &str) -> AgentConfig {
+        AgentConfig {
+            agent: AgentPersonality {
+                name: name.to_string(),
+                role: "Tester".to_string(),
+                backstory: vec!["A test agent".to_string()],
+                knowledge: vec![],
+            },
+            memory: MemoryConfig::default(),
+            inference: InferenceConfig::default(),
+            behavior: HashMap::new(),
+            moderation: crate::config::ModerationConfig::default(),
+            tts: None,
+        }
+    }
+
+    #[tokio::test]
+    async fn test_batched_emotion_decay() {
+        let scheduler = AgentScheduler::new(SchedulerConfig::default());
+
+        let agent = Arc::new(Agent::new(test_config("Decay Agent")));
+        agent.update_emotion("joy", 1.0).await;
+        scheduler.add_agent(agent.clone()).await;
+
+        let stats = scheduler.tick().await;
+        assert_eq!(stats.agents_decayed, 1);
+
+        let state = agent.emotional_state().await;
+        assert!(state.joy < 1.0, "Joy should decay after a tick");
+    }
+
+    #[tokio::test]
+    async fn test_time_sliced_inference() {
+        let config = SchedulerConfig {
+            max_inference_per_tick: 1,
+            decay_interval_ticks: 1,
+        };
+        let scheduler = AgentScheduler::new(config);
+
+        let mut ids = Vec::new();
+        for i in 0..3 {
+            let agent = Arc::new(Agent::new(test_config(&format!("Agent {}", i))));
+            agent.add_behavior(GreetingBehavior::new("Hello!")).await;
+            agent
+                .update_context(HashMap::from([(
+                    "player_distance".to_string(),
+                    serde_json::json!(1.0),
+                )]))
+                .await;
+            agent.start().await.unwrap();
+            ids.push(agent.id());
+            scheduler.add_agent(agent).await;
+        }
+
+        for id in &ids {
+            scheduler.queue_input(*id, "hello").await.unwrap();
+        }
+
+        // Only one input should be dispatched per tick.
+        let stats = scheduler.tick().await;
+        assert_eq!(stats.inference_dispatched, 1);
+        assert_eq!(stats.inference_queued, 2);
+
+        scheduler.tick().await;
+        scheduler.tick().await;
+
+        // Give spawned tasks a moment to finish (greeting behavior is local).
+        tokio::time::sleep(std::time::Duration::from_millis(100)).await;
+
+        let responses = scheduler.drain_responses().await;
+        assert_eq!(responses.len(), 3);
+        for response in responses {
+            assert_eq!(response.response.unwrap(), "Hello!");
+        }
+    }
+
+    #[tokio::test]
+    async fn test_queue_input_unknown_agent() {
+        let scheduler = AgentScheduler::new(SchedulerConfig::default());
+        let result = scheduler.queue_input(Uuid::new_v4(), "hello").await;
+        assert!(result.is_err());
+    }
+}
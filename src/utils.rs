@@ -2,11 +2,56 @@
 //!
 //! This module provides various utility functions used across the SDK.
 
-use std::time::{SystemTime, UNIX_EPOCH};
+use std::collections::hash_map::DefaultHasher;
+use std::collections::HashMap;
+use std::hash::{Hash, Hasher};
 use std::sync::atomic::{AtomicU64, Ordering};
-use regex::RegexSet;
+use std::sync::{Arc, Mutex};
+use std::time::{SystemTime, UNIX_EPOCH};
+
+use lazy_static::lazy_static;
+use regex::{RegexSet, RegexSetBuilder};
+
 use crate::Result;
 
+/// Bound on the moderation verdict cache; cleared wholesale when full so a
+/// chatty server cannot grow it without limit.
+const MODERATION_CACHE_CAPACITY: usize = 1024;
+
+lazy_static! {
+    /// Process-wide HTTP client with connection keep-alive. Building a
+    /// `reqwest::Client` sets up a fresh connection pool and TLS config, so
+    /// per-call construction costs a new handshake on every request.
+    static ref SHARED_HTTP_CLIENT: reqwest::Client = reqwest::Client::new();
+
+    /// Recent cloud moderation verdicts keyed by input hash. Players repeat
+    /// themselves, so hits skip the 80-150 ms cloud round trip entirely.
+    static ref MODERATION_VERDICTS: Mutex<HashMap<u64, bool>> =
+        Mutex::new(HashMap::new());
+
+    /// In-flight cloud moderation checks keyed by input hash. When several
+    /// agents moderate the same broadcast message concurrently, followers
+    /// wait on the leader's result instead of issuing duplicate requests.
+    static ref MODERATION_IN_FLIGHT: Mutex<HashMap<u64, tokio::sync::watch::Receiver<Option<bool>>>> =
+        Mutex::new(HashMap::new());
+
+    /// Compiled moderation pattern sets keyed by source file. Compiling a
+    /// `RegexSet` is the dominant cost of agent construction, and every agent
+    /// in a process reads the same pattern files, so each file is compiled
+    /// exactly once and shared.
+    static ref MODERATION_SETS: Mutex<HashMap<String, Arc<RegexSet>>> =
+        Mutex::new(HashMap::new());
+}
+
+/// Get the process-wide shared HTTP client
+///
+/// # Returns
+///
+/// A reference to the shared `reqwest::Client`
+pub fn http_client() -> &'static reqwest::Client {
+    &SHARED_HTTP_CLIENT
+}
+
 // Counter to ensure uniqueness even when called rapidly
 #[allow(dead_code)]
 static COUNTER: AtomicU64 = AtomicU64::new(0);
@@ -61,11 +106,41 @@ pub fn load_moderation_patterns(patterns_file: &str) -> Result<RegexSet> {
         .filter(|line| !line.is_empty() && !line.starts_with('#'))
         .collect();
     
-    RegexSet::new(&patterns).map_err(|e| 
-        crate::OxydeError::ConfigurationError(
-            format!("Failed to compile moderation regex patterns: {}", e)
+    // Compile case-insensitively so callers can scan raw input without
+    // allocating a lowercase copy first
+    RegexSetBuilder::new(&patterns)
+        .case_insensitive(true)
+        .build()
+        .map_err(|e|
+            crate::OxydeError::ConfigurationError(
+                format!("Failed to compile moderation regex patterns: {}", e)
+            )
         )
-    )
+}
+
+/// Get the shared compiled moderation pattern set for a file
+///
+/// Compiles the file with [`load_moderation_patterns`] on first use and
+/// returns the same `Arc` for every subsequent call, so spawning many agents
+/// pays the regex compilation cost once per process instead of once per
+/// agent.
+///
+/// # Arguments
+///
+/// * `patterns_file` - Path to the file containing regex patterns
+///
+/// # Returns
+///
+/// A shared compiled RegexSet or an error
+pub fn shared_moderation_patterns(patterns_file: &str) -> Result<Arc<RegexSet>> {
+    let mut sets = lock_recovering(&MODERATION_SETS);
+    if let Some(set) = sets.get(patterns_file) {
+        return Ok(Arc::clone(set));
+    }
+
+    let set = Arc::new(load_moderation_patterns(patterns_file)?);
+    sets.insert(patterns_file.to_string(), Arc::clone(&set));
+    Ok(set)
 }
 
 /// Check content using cloud moderation API (OpenAI)
@@ -85,13 +160,95 @@ pub fn load_moderation_patterns(patterns_file: &str) -> Result<RegexSet> {
 /// and ignores mild harassment to be more appropriate for game contexts where players might
 /// express frustration or be rude to NPCs.
 pub async fn check_cloud_moderation(content: &str, api_key: &str) -> Result<bool> {
-    let client = reqwest::Client::new();
-    
+    let content_hash = {
+        let mut hasher = DefaultHasher::new();
+        content.hash(&mut hasher);
+        hasher.finish()
+    };
+
+    // Serve repeated inputs from the verdict cache without a network call
+    {
+        let verdicts = lock_recovering(&MODERATION_VERDICTS);
+        if let Some(&verdict) = verdicts.get(&content_hash) {
+            return Ok(verdict);
+        }
+    }
+
+    // Coalesce concurrent checks of the same content: the first caller
+    // becomes the leader and issues the request, everyone else waits on its
+    // watch channel
+    enum Flight {
+        Leader(tokio::sync::watch::Sender<Option<bool>>),
+        Follower(tokio::sync::watch::Receiver<Option<bool>>),
+    }
+
+    let flight = {
+        let mut in_flight = lock_recovering(&MODERATION_IN_FLIGHT);
+        match in_flight.get(&content_hash) {
+            Some(receiver) => Flight::Follower(receiver.clone()),
+            None => {
+                let (sender, receiver) = tokio::sync::watch::channel(None);
+                in_flight.insert(content_hash, receiver);
+                Flight::Leader(sender)
+            }
+        }
+    };
+
+    let sender = match flight {
+        Flight::Follower(mut receiver) => {
+            return match receiver.changed().await {
+                Ok(()) => (*receiver.borrow()).ok_or_else(|| {
+                    crate::OxydeError::InferenceError(
+                        "Coalesced cloud moderation request failed".to_string(),
+                    )
+                }),
+                Err(_) => Err(crate::OxydeError::InferenceError(
+                    "Coalesced cloud moderation request failed".to_string(),
+                )),
+            };
+        }
+        Flight::Leader(sender) => sender,
+    };
+
+    let result = request_cloud_verdict(content, api_key).await;
+
+    {
+        let mut in_flight = lock_recovering(&MODERATION_IN_FLIGHT);
+        in_flight.remove(&content_hash);
+    }
+
+    match &result {
+        Ok(verdict) => {
+            let mut verdicts = lock_recovering(&MODERATION_VERDICTS);
+            if verdicts.len() >= MODERATION_CACHE_CAPACITY {
+                verdicts.clear();
+            }
+            verdicts.insert(content_hash, *verdict);
+            let _ = sender.send(Some(*verdict));
+        }
+        Err(_) => {
+            // Dropping the sender wakes followers with an error
+            drop(sender);
+        }
+    }
+
+    result
+}
+
+fn lock_recovering<T>(mutex: &Mutex<T>) -> std::sync::MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(|poisoned| {
+        log::warn!("Moderation lock poisoned, recovering");
+        poisoned.into_inner()
+    })
+}
+
+/// Issue one moderation request against the cloud API
+async fn request_cloud_verdict(content: &str, api_key: &str) -> Result<bool> {
     let request_body = serde_json::json!({
         "input": content
     });
-    
-    let response = client
+
+    let response = http_client()
         .post("https://api.openai.com/v1/moderations")
         .header("Authorization", format!("Bearer {}", api_key))
         .header("Content-Type", "application/json")
@@ -230,4 +387,16 @@ mod tests {
         assert_eq!(truncated.len(), 20);
         assert!(truncated.ends_with("..."));
     }
+
+    #[test]
+    fn test_moderation_patterns_match_case_insensitively() {
+        let path = std::env::temp_dir().join("oxyde_test_badwords.txt");
+        std::fs::write(&path, "badword\n# a comment\n\n").unwrap();
+
+        let patterns = load_moderation_patterns(path.to_str().unwrap()).unwrap();
+        assert!(patterns.is_match("you total BadWord"));
+        assert!(!patterns.is_match("a perfectly fine sentence"));
+
+        std::fs::remove_file(&path).ok();
+    }
 }
\ No newline at end of file
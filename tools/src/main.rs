@@ -3,20 +3,47 @@
 //! This command-line tool allows developers to create, test, and deploy
 //! AI-powered NPC agents for games.
 
+use std::alloc::{GlobalAlloc, Layout, System};
 use std::collections::HashMap;
 use std::fs;
 use std::path::{Path, PathBuf};
 use std::process;
-use std::time::Duration;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
 
 use clap::{Parser, Subcommand};
-use oxyde::agent::{Agent, AgentState};
+use oxyde::agent::{Agent, AgentFactory, AgentState};
 use oxyde::config::{AgentConfig, BehaviorConfig, InferenceConfig, MemoryConfig};
 use oxyde::oxyde_game::behavior::factory;
 use oxyde::oxyde_game::intent::Intent;
 use oxyde::{OxydeError, Result};
 use tokio::time::sleep;
 
+/// Allocation-counting wrapper around the system allocator
+///
+/// Lets the replay harness report allocation counts per stage without an
+/// external profiler. The relaxed atomic increment is cheap enough to leave
+/// enabled for the whole CLI.
+struct CountingAllocator;
+
+/// Total number of heap allocations made by the process
+static ALLOCATION_COUNT: AtomicU64 = AtomicU64::new(0);
+
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        ALLOCATION_COUNT.fetch_add(1, Ordering::Relaxed);
+        System.alloc(layout)
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        System.dealloc(ptr, layout)
+    }
+}
+
+#[global_allocator]
+static GLOBAL_ALLOCATOR: CountingAllocator = CountingAllocator;
+
 /// CLI arguments parser
 #[derive(Parser)]
 #[clap(author, version, about = "CLI tool for Oxyde SDK")]
@@ -87,15 +114,54 @@ enum Commands {
         /// Input configuration file
         #[clap(short, long)]
         input: String,
-        
+
         /// Output format (json, yaml)
         #[clap(short, long, default_value = "json")]
         format: String,
-        
+
         /// Output file path
         #[clap(short, long)]
         output: String,
     },
+
+    /// Replay recorded player inputs against a fleet of agents
+    Replay {
+        /// JSONL file of recorded inputs (objects with an "input", "text",
+        /// or "body" field, or bare strings)
+        #[clap(short, long)]
+        input: String,
+
+        /// Path to the agent configuration file for the fleet
+        #[clap(short, long)]
+        config: String,
+
+        /// Number of agents in the fleet
+        #[clap(long, default_value = "8")]
+        agents: usize,
+
+        /// Maximum number of in-flight requests
+        #[clap(long, default_value = "16")]
+        concurrency: usize,
+
+        /// Target arrival rate in requests per second (0 = unthrottled)
+        #[clap(long, default_value = "0")]
+        rate: u64,
+
+        /// Use local inference only (mock-friendly, no network)
+        #[clap(long)]
+        local_only: bool,
+    },
+
+    /// Compile agent configurations into the preparsed binary format
+    Compile {
+        /// Input configuration file(s) (JSON or YAML)
+        #[clap(short, long)]
+        config: Vec<String>,
+
+        /// Output directory (defaults to writing the .oxc next to each input)
+        #[clap(short, long)]
+        output: Option<String>,
+    },
 }
 
 /// Run the CLI tool
@@ -133,6 +199,12 @@ async fn main() -> Result<()> {
         Commands::Convert { input, format, output } => {
             convert_agent_config(&input, &format, &output).await?;
         }
+        Commands::Replay { input, config, agents, concurrency, rate, local_only } => {
+            replay_traffic(&input, &config, agents, concurrency, rate, local_only).await?;
+        }
+        Commands::Compile { config, output } => {
+            compile_agent_configs(&config, output.as_deref()).await?;
+        }
     }
     
     Ok(())
@@ -177,7 +249,8 @@ async fn create_agent_config(name: &str, role: &str, output: &str) -> Result<()>
         let json = serde_json::to_string_pretty(&agent_config)?;
         fs::write(output, json)?;
     } else {
-        let yaml = serde_yaml::to_string(&agent_config)?;
+        let yaml = serde_yaml::to_string(&agent_config)
+            .map_err(|e| OxydeError::CliError(format!("Failed to serialize YAML config: {}", e)))?;
         fs::write(output, yaml)?;
     }
     
@@ -650,7 +723,7 @@ namespace Oxyde.Unity
             for (int i = 0; i < Mathf.Min(agentPrefabs.Length, positions.Length); i++)
             {{
                 GameObject agentObject = Instantiate(agentPrefabs[i], positions[i], Quaternion.identity);
-                agentObject.name = $"NPC_{i}";
+                agentObject.name = $"NPC_{{i}}";
             }}
             
             Debug.Log($"Spawned {{Mathf.Min(agentPrefabs.Length, positions.Length)}} agents");
@@ -1591,7 +1664,8 @@ async fn convert_agent_config(
             fs::write(output_path, json)?;
         },
         "yaml" | "yml" => {
-            let yaml = serde_yaml::to_string(&config)?;
+            let yaml = serde_yaml::to_string(&config)
+                .map_err(|e| OxydeError::CliError(format!("Failed to serialize YAML config: {}", e)))?;
             fs::write(output_path, yaml)?;
         },
         _ => {
@@ -1602,3 +1676,210 @@ async fn convert_agent_config(
     println!("Conversion complete");
     Ok(())
 }
+
+/// Extract the player input text from one line of a replay file
+///
+/// Accepts JSON objects carrying an "input", "text", or "body" string field
+/// (the repo's own requests.jsonl works out of the box), JSON strings, or
+/// bare text lines.
+fn parse_replay_line(line: &str) -> Option<String> {
+    let trimmed = line.trim();
+    if trimmed.is_empty() {
+        return None;
+    }
+
+    match serde_json::from_str::<serde_json::Value>(trimmed) {
+        Ok(serde_json::Value::Object(object)) => ["input", "text", "body"]
+            .iter()
+            .find_map(|key| object.get(*key).and_then(|v| v.as_str()))
+            .map(String::from),
+        Ok(serde_json::Value::String(text)) => Some(text),
+        _ => Some(trimmed.to_string()),
+    }
+}
+
+/// Format a latency duration in milliseconds with sub-millisecond precision
+fn format_latency(duration: Duration) -> String {
+    format!("{:.2}ms", duration.as_secs_f64() * 1000.0)
+}
+
+/// Replay a JSONL stream of recorded inputs against a fleet of agents
+async fn replay_traffic(
+    input_path: &str,
+    config_path: &str,
+    agent_count: usize,
+    concurrency: usize,
+    rate: u64,
+    local_only: bool,
+) -> Result<()> {
+    if agent_count == 0 || concurrency == 0 {
+        return Err(OxydeError::CliError(
+            "Agent count and concurrency must both be greater than 0".to_string()
+        ));
+    }
+
+    let contents = fs::read_to_string(input_path)?;
+    let inputs: Vec<String> = contents.lines().filter_map(parse_replay_line).collect();
+    if inputs.is_empty() {
+        return Err(OxydeError::CliError(
+            format!("No usable inputs found in {}", input_path)
+        ));
+    }
+
+    let mut config = AgentConfig::from_file(config_path)?;
+    if local_only {
+        config.inference.use_local = true;
+    }
+
+    println!("Replaying {} inputs against {} agent(s), concurrency {}, rate {}",
+        inputs.len(),
+        agent_count,
+        concurrency,
+        if rate == 0 { "unthrottled".to_string() } else { format!("{}/s", rate) });
+
+    // ---- Setup stage ----
+    let setup_allocs_before = ALLOCATION_COUNT.load(Ordering::Relaxed);
+    let setup_started = Instant::now();
+
+    let fleet_factory = AgentFactory::new(config);
+    let mut fleet = Vec::with_capacity(agent_count);
+    for index in 0..agent_count {
+        let agent = Arc::new(fleet_factory.spawn_named(&format!("replay-agent-{}", index)));
+        agent.start().await?;
+        fleet.push(agent);
+    }
+
+    let setup_elapsed = setup_started.elapsed();
+    let setup_allocs = ALLOCATION_COUNT.load(Ordering::Relaxed) - setup_allocs_before;
+
+    // ---- Replay stage ----
+    let semaphore = Arc::new(tokio::sync::Semaphore::new(concurrency));
+    let latencies = Arc::new(Mutex::new(Vec::with_capacity(inputs.len())));
+    let failures = Arc::new(AtomicUsize::new(0));
+
+    // Pace arrivals with a fixed-rate ticker when a rate was requested;
+    // otherwise admission is limited only by the concurrency semaphore
+    let mut ticker = if rate > 0 {
+        Some(tokio::time::interval(Duration::from_secs_f64(1.0 / rate as f64)))
+    } else {
+        None
+    };
+
+    let replay_allocs_before = ALLOCATION_COUNT.load(Ordering::Relaxed);
+    let replay_started = Instant::now();
+
+    let mut handles = Vec::with_capacity(inputs.len());
+    for (index, input) in inputs.into_iter().enumerate() {
+        if let Some(ticker) = ticker.as_mut() {
+            ticker.tick().await;
+        }
+
+        let permit = Arc::clone(&semaphore).acquire_owned().await.map_err(|e| {
+            OxydeError::CliError(format!("Replay semaphore closed: {}", e))
+        })?;
+        let agent = Arc::clone(&fleet[index % fleet.len()]);
+        let latencies = Arc::clone(&latencies);
+        let failures = Arc::clone(&failures);
+
+        handles.push(tokio::spawn(async move {
+            let request_started = Instant::now();
+            let result = agent.process_input(&input).await;
+            let elapsed = request_started.elapsed();
+            drop(permit);
+
+            match result {
+                Ok(_) => {
+                    let mut latencies = latencies.lock().unwrap_or_else(|p| p.into_inner());
+                    latencies.push(elapsed);
+                }
+                Err(err) => {
+                    log::debug!("Replay request failed: {}", err);
+                    failures.fetch_add(1, Ordering::Relaxed);
+                }
+            }
+        }));
+    }
+
+    for handle in handles {
+        let _ = handle.await;
+    }
+
+    let wall_time = replay_started.elapsed();
+    let replay_allocs = ALLOCATION_COUNT.load(Ordering::Relaxed) - replay_allocs_before;
+
+    for agent in &fleet {
+        agent.stop().await?;
+    }
+
+    // ---- Report ----
+    let mut latencies = latencies.lock().unwrap_or_else(|p| p.into_inner()).clone();
+    latencies.sort_unstable();
+    let completed = latencies.len();
+    let failed = failures.load(Ordering::Relaxed);
+
+    let percentile = |p: f64| -> Duration {
+        if latencies.is_empty() {
+            return Duration::ZERO;
+        }
+        let index = ((latencies.len() - 1) as f64 * p / 100.0).round() as usize;
+        latencies[index]
+    };
+
+    println!("\n=== Replay Report ===");
+    println!("Completed:     {} ({} failed)", completed, failed);
+    println!("Wall time:     {:.2}s", wall_time.as_secs_f64());
+    if wall_time.as_secs_f64() > 0.0 {
+        println!("Throughput:    {:.1} inputs/sec", completed as f64 / wall_time.as_secs_f64());
+    }
+    if completed > 0 {
+        println!("Latency p50:   {}", format_latency(percentile(50.0)));
+        println!("Latency p95:   {}", format_latency(percentile(95.0)));
+        println!("Latency p99:   {}", format_latency(percentile(99.0)));
+        println!("Latency max:   {}", format_latency(*latencies.last().unwrap()));
+    }
+    println!("Setup:         {:.2}s, {} allocations ({} per agent)",
+        setup_elapsed.as_secs_f64(), setup_allocs, setup_allocs / agent_count as u64);
+    if completed + failed > 0 {
+        println!("Replay allocs: {} total, {} per request",
+            replay_allocs, replay_allocs / (completed + failed) as u64);
+    }
+
+    Ok(())
+}
+
+/// Compile agent configurations into the preparsed binary .oxc format
+async fn compile_agent_configs(configs: &[String], output_dir: Option<&str>) -> Result<()> {
+    if configs.is_empty() {
+        return Err(OxydeError::CliError(
+            "At least one configuration file is required (--config)".to_string()
+        ));
+    }
+
+    // Create the output directory up front if one was given
+    if let Some(dir) = output_dir {
+        fs::create_dir_all(dir)?;
+    }
+
+    for config_path in configs {
+        // Parse and validate the source config; compilation refuses to
+        // produce a binary from an invalid file
+        let config = AgentConfig::from_file(config_path)?;
+
+        let input = Path::new(config_path);
+        let output_path = match output_dir {
+            Some(dir) => {
+                let file_name = input.file_stem().ok_or_else(|| {
+                    OxydeError::CliError(format!("Invalid config file name: {}", config_path))
+                })?;
+                PathBuf::from(dir).join(file_name).with_extension("oxc")
+            }
+            None => input.with_extension("oxc"),
+        };
+
+        config.save_compiled(&output_path)?;
+        println!("Compiled {} -> {}", config_path, output_path.display());
+    }
+
+    println!("Compiled {} configuration(s)", configs.len());
+    Ok(())
+}